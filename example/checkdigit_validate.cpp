@@ -0,0 +1,219 @@
+//! \file
+//! \brief Command-line validator of identifiers stored one per line or in a column of a CSV file.
+
+// Copyright Pierre Talbot 2013.
+
+// Use, modification and distribution are subject to the
+// Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Usage: checkdigit-validate <scheme> <file> [--column N] [--delimiter C] [--threads N] [--quiet]
+//
+// The file is mapped in memory and split into line-aligned chunks, one per thread. The line and
+// field boundaries are found with memchr, which the C library implements with SIMD instructions.
+// The numbers of the invalid lines (from 1) are written on the standard output, the counts on the
+// standard error.
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstring>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+#include <algorithm>
+
+#include <boost/range/iterator_range.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+#include <boost/checkdigit/checks_fwd.hpp>
+#include <boost/checkdigit/precheck.hpp>
+
+using namespace boost::checkdigit;
+
+typedef bool (*field_validator)(const char *, const char *);
+
+template <typename Features, typename Precheck>
+bool validate_field(const char *begin, const char *end)
+{
+  boost::iterator_range<const char*> field(begin, end);
+  return check_sequence<Features>(make_precheck<Precheck>(field));
+}
+
+bool validate_mod97_10(const char *begin, const char *end)
+{
+  boost::iterator_range<const char*> field(begin, end);
+  return check_mod97_10(make_precheck<digit>(field));
+}
+
+struct scheme
+{
+  const char *name;
+  field_validator validate;
+};
+
+const scheme schemes[] =
+{
+  { "luhn",       &validate_field<features<luhn>, digit> },
+  { "verhoeff",   &validate_field<features<verhoeff>, digit> },
+  { "ean13",      &validate_field<ean13, digit> },
+  { "ean8",       &validate_field<ean8, digit> },
+  { "upca",       &validate_field<upca, digit> },
+  { "isbn10",     &validate_field<isbn10, digitx> },
+  { "isbn13",     &validate_field<isbn13, digit> },
+  { "visa",       &validate_field<visa, digit> },
+  { "amex",       &validate_field<amex, digit> },
+  { "mastercard", &validate_field<mastercard, digit> },
+  { "mod97_10",   &validate_mod97_10 }
+};
+
+struct chunk_result
+{
+  size_t lines;
+  std::vector<size_t> invalid_lines; // Line indexes relative to the chunk.
+};
+
+struct chunk_validator
+{
+  const char *begin;
+  const char *end;
+  field_validator validate;
+  size_t column;
+  char delimiter;
+  chunk_result *result;
+
+  void operator()() const
+  {
+    size_t line = 0;
+    for(const char *first = begin; first != end; ++line)
+    {
+      const char *last = static_cast<const char*>(std::memchr(first, '\n', end - first));
+      if(last == 0)
+        last = end;
+
+      // Skip to the field of the column.
+      const char *field = first;
+      for(size_t c = 0; c < column && field != 0; ++c)
+      {
+        field = static_cast<const char*>(std::memchr(field, delimiter, last - field));
+        if(field != 0)
+          ++field;
+      }
+      const char *field_end = field == 0 ? 0 : static_cast<const char*>(std::memchr(field, delimiter, last - field));
+      if(field_end == 0)
+        field_end = last;
+      if(field_end != field && field_end[-1] == '\r')
+        --field_end;
+
+      if(field == 0 || !validate(field, field_end))
+        result->invalid_lines.push_back(line);
+
+      first = last == end ? end : last + 1;
+    }
+    result->lines = line;
+  }
+};
+
+int usage()
+{
+  std::cerr << "Usage: checkdigit-validate <scheme> <file> [--column N] [--delimiter C] [--threads N] [--quiet]\n"
+            << "Schemes:";
+  for(size_t i = 0; i < sizeof(schemes) / sizeof(schemes[0]); ++i)
+    std::cerr << ' ' << schemes[i].name;
+  std::cerr << std::endl;
+  return 2;
+}
+
+int main(int argc, char *argv[])
+{
+  if(argc < 3)
+    return usage();
+
+  field_validator validate = 0;
+  for(size_t i = 0; i < sizeof(schemes) / sizeof(schemes[0]); ++i)
+    if(std::strcmp(argv[1], schemes[i].name) == 0)
+      validate = schemes[i].validate;
+  if(validate == 0)
+    return usage();
+
+  size_t column = 0;
+  char delimiter = ',';
+  size_t threads = std::max<size_t>(1, std::thread::hardware_concurrency());
+  bool quiet = false;
+  for(int i = 3; i < argc; ++i)
+  {
+    std::string option = argv[i];
+    if(option == "--quiet")
+      quiet = true;
+    else if(i + 1 == argc)
+      return usage();
+    else if(option == "--column")
+      column = std::strtoul(argv[++i], 0, 10);
+    else if(option == "--delimiter")
+      delimiter = argv[++i][0];
+    else if(option == "--threads")
+      threads = std::max<size_t>(1, std::strtoul(argv[++i], 0, 10));
+    else
+      return usage();
+  }
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+
+  boost::interprocess::mapped_region region;
+  try
+  {
+    boost::interprocess::file_mapping file(argv[2], boost::interprocess::read_only);
+    boost::interprocess::mapped_region(file, boost::interprocess::read_only).swap(region);
+  }
+  catch(const boost::interprocess::interprocess_exception &e)
+  {
+    std::cerr << argv[2] << ": " << e.what() << std::endl;
+    return 2;
+  }
+  const char *data = static_cast<const char*>(region.get_address());
+  size_t size = region.get_size();
+
+  // Split into line-aligned chunks: each chunk ends just after a new line.
+  std::vector<const char*> bounds(1, data);
+  for(size_t t = 1; t < threads; ++t)
+  {
+    const char *cut = std::max(bounds.back(), data + size * t / threads);
+    const char *new_line = static_cast<const char*>(std::memchr(cut, '\n', data + size - cut));
+    if(new_line == 0)
+      break;
+    bounds.push_back(new_line + 1);
+  }
+  bounds.push_back(data + size);
+
+  size_t chunks = bounds.size() - 1;
+  std::vector<chunk_result> results(chunks);
+  std::vector<std::thread> pool;
+  for(size_t c = 0; c < chunks; ++c)
+  {
+    chunk_validator validator = { bounds[c], bounds[c + 1], validate, column, delimiter, &results[c] };
+    pool.push_back(std::thread(validator));
+  }
+  for(size_t c = 0; c < chunks; ++c)
+    pool[c].join();
+
+  size_t lines = 0;
+  size_t invalid = 0;
+  for(size_t c = 0; c < chunks; ++c)
+  {
+    if(!quiet)
+      for(size_t i = 0; i < results[c].invalid_lines.size(); ++i)
+        std::cout << lines + results[c].invalid_lines[i] + 1 << '\n';
+    lines += results[c].lines;
+    invalid += results[c].invalid_lines.size();
+  }
+  std::cout.flush();
+
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  std::cerr << lines << " lines, " << invalid << " invalid, "
+            << std::fixed << std::setprecision(2) << size / elapsed.count() / 1e9 << " GB/s on "
+            << chunks << " thread(s)" << std::endl;
+  return invalid == 0 ? 0 : 1;
+}
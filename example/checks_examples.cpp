@@ -28,7 +28,7 @@
 //]
 
 //[mod97_10_include_file
-#include <boost/checkdigit/modulus97.hpp>
+#include <boost/checkdigit/modulus97_10.hpp>
 //]
 
 //[ean_include_file
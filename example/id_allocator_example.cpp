@@ -0,0 +1,117 @@
+// Copyright Pierre Talbot 2013.
+
+// Use, modification and distribution are subject to the
+// Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Contention benchmark of id_allocator: 1 to 64 threads take valid identifiers
+// from a shared range, compared with a counter and compute_checkdigit under a mutex.
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+#include <mutex>
+
+#include <boost/cstdint.hpp>
+#include <boost/lexical_cast.hpp>
+#include <boost/checkdigit/luhn.hpp>
+#include <boost/checkdigit/precheck.hpp>
+#include <boost/checkdigit/id_allocator.hpp>
+
+using namespace boost::checkdigit;
+
+typedef id_allocator<features<luhn> > allocator_type;
+
+struct lock_free_worker
+{
+  allocator_type *allocator;
+  size_t *checksum;
+
+  void operator()() const
+  {
+    allocator_type::block block;
+    size_t sum = 0;
+    for(const char *id = allocator->allocate_id(block); id != 0; id = allocator->allocate_id(block))
+      sum += id[block.id_size() - 1];
+    *checksum = sum;
+  }
+};
+
+struct mutex_worker
+{
+  std::mutex *mutex;
+  boost::uint64_t *counter;
+  boost::uint64_t last;
+  size_t *checksum;
+
+  void operator()() const
+  {
+    size_t sum = 0;
+    for(;;)
+    {
+      std::string id;
+      {
+        std::lock_guard<std::mutex> lock(*mutex);
+        if(*counter > last)
+          break;
+        id = boost::lexical_cast<std::string>((*counter)++);
+        id += static_cast<char>('0' + compute_luhn<15>(make_precheck<digit>(id)));
+      }
+      sum += id[id.size() - 1];
+    }
+    *checksum = sum;
+  }
+};
+
+template <typename Worker>
+double run(std::vector<Worker> &workers)
+{
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  std::vector<std::thread> threads;
+  for(size_t t = 0; t < workers.size(); ++t)
+    threads.push_back(std::thread(workers[t]));
+  for(size_t t = 0; t < threads.size(); ++t)
+    threads[t].join();
+  return std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+}
+
+int main(int argc, char *argv[])
+{
+  boost::uint64_t count = argc > 1 ? std::strtoull(argv[1], 0, 10) : 10000000;
+  boost::uint64_t first = 100000000000000ull;
+
+  std::cout << std::setw(8) << "threads" << std::setw(16) << "lock-free M/s" << std::setw(14) << "mutex M/s" << std::endl;
+  for(size_t threads = 1; threads <= 64; threads *= 2)
+  {
+    std::vector<size_t> checksums(threads);
+
+    allocator_type allocator(first, first + count - 1, 15);
+    std::vector<lock_free_worker> lock_free(threads);
+    for(size_t t = 0; t < threads; ++t)
+    {
+      lock_free[t].allocator = &allocator;
+      lock_free[t].checksum = &checksums[t];
+    }
+    double lock_free_time = run(lock_free);
+
+    std::mutex mutex;
+    boost::uint64_t counter = first;
+    std::vector<mutex_worker> locked(threads);
+    for(size_t t = 0; t < threads; ++t)
+    {
+      mutex_worker worker = { &mutex, &counter, first + count - 1, &checksums[t] };
+      locked[t] = worker;
+    }
+    double mutex_time = run(locked);
+
+    std::cout << std::setw(8) << threads << std::fixed << std::setprecision(2)
+              << std::setw(16) << count / lock_free_time / 1e6
+              << std::setw(14) << count / mutex_time / 1e6 << std::endl;
+  }
+  return 0;
+}
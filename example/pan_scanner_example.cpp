@@ -0,0 +1,57 @@
+// Copyright Pierre Talbot 2013.
+
+// Use, modification and distribution are subject to the
+// Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Scan a generated text for card numbers, in one call and in chunks of 64 KB,
+// and report the throughput of pan_scanner.
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <chrono>
+#include <iterator>
+#include <algorithm>
+
+#include <boost/checkdigit/pan_scanner.hpp>
+
+using namespace boost::checkdigit;
+
+int main(int argc, char *argv[])
+{
+  size_t size = argc > 1 ? std::strtoul(argv[1], 0, 10) : 256 << 20;
+
+  // Mostly prose with a few numbers, dates and card numbers.
+  const char *words[] = { "the ", "invoice ", "customer ", "paid ", "on ", "2013-06-14 ", "ref ", "4417 1234 5678 9113 ",
+                          "and ", "order ", "no. ", "123456 ", "card ", "3782-822463-10005 ", "total ", "42.50\n" };
+  std::string text;
+  text.reserve(size + 32);
+  std::srand(42);
+  while(text.size() < size)
+    text += words[std::rand() % (sizeof(words) / sizeof(words[0]))];
+
+  std::vector<pan_match> matches;
+  matches.reserve(text.size() / 64);
+
+  std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+  scan_pan(text.data(), text.size(), std::back_inserter(matches));
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << "single call:  " << matches.size() << " matches, " << std::fixed << std::setprecision(2)
+            << text.size() / elapsed.count() / 1e9 << " GB/s" << std::endl;
+
+  matches.clear();
+  start = std::chrono::steady_clock::now();
+  pan_scanner scanner;
+  const size_t chunk_size = 1 << 16;
+  for(size_t offset = 0; offset < text.size(); offset += chunk_size)
+    scanner.scan(text.data() + offset, (std::min)(chunk_size, text.size() - offset), std::back_inserter(matches));
+  scanner.finish(std::back_inserter(matches));
+  elapsed = std::chrono::steady_clock::now() - start;
+  std::cout << "64 KB chunks: " << matches.size() << " matches, " << std::fixed << std::setprecision(2)
+            << text.size() / elapsed.count() / 1e9 << " GB/s" << std::endl;
+  return 0;
+}
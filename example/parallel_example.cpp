@@ -0,0 +1,62 @@
+// Copyright Pierre Talbot 2013.
+
+// Use, modification and distribution are subject to the
+// Boost Software License, Version 1.0.
+// (See accompanying file LICENSE_1_0.txt
+// or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// Validate a large collection of card numbers on several threads and report
+// the throughput for several chunk sizes, to tune BOOST_CHECKDIGIT_DEFAULT_CHUNK_SIZE.
+
+#include <iostream>
+#include <iomanip>
+#include <string>
+#include <vector>
+#include <cstdlib>
+#include <chrono>
+#include <thread>
+
+#include <boost/checkdigit/luhn.hpp>
+#include <boost/checkdigit/visa.hpp>
+#include <boost/checkdigit/parallel.hpp>
+
+using namespace boost::checkdigit;
+
+int main(int argc, char *argv[])
+{
+  size_t count = argc > 1 ? std::strtoul(argv[1], 0, 10) : 4000000;
+
+  std::vector<std::string> numbers(count);
+  std::srand(42);
+  for(size_t i = 0; i < count; ++i)
+  {
+    std::string &number = numbers[i];
+    number.resize(VISA_SIZE);
+    number[0] = '4';
+    for(size_t j = 1; j < VISA_SIZE - 1; ++j)
+      number[j] = '0' + std::rand() % 10;
+    number[VISA_SIZE - 1] = '0' + compute_visa(number.substr(0, VISA_SIZE - 1));
+    if(i % 10 == 0)
+      number[5] = number[5] == '9' ? '0' : number[5] + 1;
+  }
+
+  std::vector<bitmap_word> bitmap(bitmap_size(count));
+  size_t hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+  size_t chunk_sizes[] = { 512, 2048, 8192, 16384, 65536, 262144 };
+
+  std::cout << std::setw(8) << "threads" << std::setw(12) << "chunk size"
+            << std::setw(14) << "M numbers/s" << std::setw(10) << "valid" << std::endl;
+  for(size_t threads = 1; threads <= hardware_threads; threads *= 2)
+  {
+    for(size_t i = 0; i < sizeof(chunk_sizes) / sizeof(chunk_sizes[0]); ++i)
+    {
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      size_t valid = check_sequence<visa, digit>(numbers.begin(), numbers.end(), &bitmap[0], threads, chunk_sizes[i]);
+      std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+      std::cout << std::setw(8) << threads << std::setw(12) << chunk_sizes[i]
+                << std::setw(14) << std::fixed << std::setprecision(2) << count / elapsed.count() / 1e6
+                << std::setw(10) << valid << std::endl;
+    }
+  }
+  return 0;
+}
@@ -0,0 +1,223 @@
+//  Boost checks/barcode.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief This file provides tools to compute and validate the check symbol of the Code 128 and Code 39 barcode symbologies.
+
+    \details The check symbol of Code 128 is the start symbol value plus the symbol values weighted by their
+    position (1, 2, 3...) modulus 103. The check character of Code 39 is the sum of the character values modulus 43.
+*/
+
+#ifndef BOOST_CHECKDIGIT_BARCODE_HPP
+#define BOOST_CHECKDIGIT_BARCODE_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+#include <string>
+#include <boost/next_prior.hpp>
+#include <boost/iterator/transform_iterator.hpp>
+
+#include <boost/checkdigit/basic_checks.hpp>
+#include <boost/checkdigit/positional_weight.hpp>
+
+/*!
+  \brief This macro defines the modulus of the Code 128 check symbol.
+*/
+#define CODE128_MODULUS 103
+/*!
+  \brief This macro defines the modulus of the Code 39 check character.
+*/
+#define CODE39_MODULUS 43
+
+namespace boost {
+    namespace checkdigit{
+
+/*!
+  \brief Values of the Code 128 start symbols.
+*/
+static const size_t code128_start_a = 103;
+static const size_t code128_start_b = 104;
+static const size_t code128_start_c = 105;
+
+/*!
+  \brief The weights of the Code 128 symbols following the start symbol, from the left: 1, 2, 3...
+*/
+typedef linear_weight<1> code128_weight;
+
+/*!
+  \brief Transliterate a character into its value in the Code 128 code set B (ASCII 32 to 127).
+
+  \returns The symbol value in [0..95], or bad_sequence if the character is not in the code set B.
+*/
+struct code128b_transliteration
+{
+  typedef size_t result_type;
+
+  template <typename value_type>
+  size_t operator()(const value_type &value) const
+  {
+    size_t symbol = static_cast<unsigned char>(value) - size_t(32);
+    return symbol < 96 ? symbol : bad_sequence;
+  }
+};
+
+/*!
+    \brief Calculate the Code 128 check symbol.
+
+    \tparam Iterator must meet the ForwardIterator requirements, its values are the symbol values.
+    \param first is the first symbol following the start symbol.
+    \param last is the end of the data symbols.
+    \param start is the value of the start symbol.
+
+    \returns The check symbol value in [0..102], or bad_sequence if a value is not a symbol value.
+*/
+template <typename Iterator>
+size_t compute_code128(Iterator first, Iterator last, size_t start)
+{
+  // A single pass from the first symbol: its weight is 1 while the prefix sums weight the last symbol by 0.
+  size_t sum, weighted_sum;
+  size_t count = detail::prefix_sums(first, last, sum, weighted_sum, CODE128_MODULUS);
+  if(count == bad_sequence)
+    return bad_sequence;
+  return (start + count * sum - weighted_sum) % CODE128_MODULUS;
+}
+
+/*!
+    \brief Calculate the Code 128 check symbol of data encoded in the code set B.
+
+    \param data is the data, without start, check and stop symbols.
+
+    \returns The check symbol value in [0..102], or bad_sequence if a character is not in the code set B.
+*/
+inline size_t compute_code128b(const std::string& data)
+{
+  typedef boost::transform_iterator<code128b_transliteration, std::string::const_iterator> iterator;
+  return compute_code128(iterator(data.begin()), iterator(data.end()), code128_start_b);
+}
+
+/*!
+    \brief Validate the Code 128 check symbol of data encoded in the code set B.
+
+    \param data is the data, without start, check and stop symbols.
+    \param check_symbol is the value of the check symbol read.
+
+    \returns @c true if the check symbol is correct, @c false otherwise.
+*/
+inline bool check_code128b(const std::string& data, size_t check_symbol)
+{
+  size_t expected = compute_code128b(data);
+  return expected != bad_sequence && expected == check_symbol;
+}
+
+namespace detail
+{
+static const char code39_charset[] = "0123456789ABCDEFGHIJKLMNOPQRSTUVWXYZ-. $/+%";
+} // namespace detail
+
+/*!
+  \brief Transliterate a character into its Code 39 value.
+
+  \returns The value in [0..42], or bad_sequence if the character is not in the Code 39 character set.
+*/
+struct code39_transliteration
+{
+  typedef size_t result_type;
+
+  template <typename value_type>
+  size_t operator()(const value_type &value) const
+  {
+    if(value >= '0' && value <= '9')
+      return value - '0';
+    if(value >= 'A' && value <= 'Z')
+      return value - 'A' + 10;
+    for(size_t i = 36; i < CODE39_MODULUS; ++i)
+      if(detail::code39_charset[i] == value)
+        return i;
+    return bad_sequence;
+  }
+};
+
+/*!
+    \brief Calculate the Code 39 modulus 43 check character.
+
+    \tparam Iterator must meet the InputIterator requirements, its values are characters.
+    \param first is the first character of the data, without start character.
+    \param last is the end of the data, without stop character.
+
+    \returns The check character, or bad_sequence if a character is not in the Code 39 character set.
+*/
+template <typename Iterator>
+size_t compute_code39(Iterator first, Iterator last)
+{
+  code39_transliteration transliteration;
+  size_t sum = 0;
+  for(; first != last; ++first)
+  {
+    size_t value = transliteration(*first);
+    if(value == bad_sequence)
+      return bad_sequence;
+    sum += value;
+  }
+  return detail::code39_charset[sum % CODE39_MODULUS];
+}
+
+/*!
+    \brief Calculate the Code 39 modulus 43 check character.
+
+    \param data is the data, without start and stop characters.
+
+    \returns The check character, or bad_sequence if a character is not in the Code 39 character set.
+*/
+inline size_t compute_code39(const std::string& data)
+{
+  return compute_code39(data.begin(), data.end());
+}
+
+/*!
+    \brief Validate a Code 39 sequence ending with its modulus 43 check character.
+
+    \tparam Iterator must meet the ForwardIterator requirements, its values are characters.
+    \param first is the first character of the data, without start character.
+    \param last is the end of the check character, without stop character.
+
+    \returns @c true if the check character is correct, @c false otherwise.
+*/
+template <typename Iterator>
+bool check_code39(Iterator first, Iterator last)
+{
+  if(first == last)
+    return false;
+  code39_transliteration transliteration;
+  size_t sum = 0;
+  // first stops on the check character.
+  for(Iterator next = boost::next(first); next != last; first = next++)
+  {
+    size_t value = transliteration(*first);
+    if(value == bad_sequence)
+      return false;
+    sum += value;
+  }
+  return *first == detail::code39_charset[sum % CODE39_MODULUS];
+}
+
+/*!
+    \brief Validate a Code 39 sequence ending with its modulus 43 check character.
+
+    \param x is the data followed by the check character, without start and stop characters.
+
+    \returns @c true if the check character is correct, @c false otherwise.
+*/
+inline bool check_code39(const std::string& x)
+{
+  return check_code39(x.begin(), x.end());
+}
+
+}} // namespace boost   namespace checkdigit
+#endif // BOOST_CHECKDIGIT_BARCODE_HPP
@@ -84,7 +84,7 @@ bool check_sequence(const range &x)
   if(checksum == bad_sequence)
     return false;
 
-  return chec
+  return typename features::checksum::validate_checkdigit()(checksum);
 }
 
 /*!
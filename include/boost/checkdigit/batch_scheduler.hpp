@@ -0,0 +1,188 @@
+//  Boost checks/batch_scheduler.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief Validate a batch of sequences of different schemes, grouped by scheme and size.
+
+    \details Each sequence is tagged with its scheme. The sequences are sorted stably by (tag, size), so a bucket holds
+    the sequences of a scheme with the same size in their input order. The sequences of a bucket are gathered into a
+    fixed size column and validated by check_fixed_column, whose batch path processes many sequences of the same scheme
+    together, then the results are scattered back to the input order. With a kernel_planner, a bucket is validated by the
+    kernel planned for its scheme and size instead.
+*/
+
+#ifndef BOOST_CHECKDIGIT_BATCH_SCHEDULER_HPP
+#define BOOST_CHECKDIGIT_BATCH_SCHEDULER_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <boost/cstdint.hpp>
+
+#include <boost/checkdigit/columnar.hpp>
+#include <boost/checkdigit/kernel_planner.hpp>
+
+namespace boost {
+    namespace checkdigit{
+
+/*!
+  \brief A sequence and the tag of its scheme.
+*/
+struct tagged_sequence
+{
+  size_t tag;
+  const char *data;
+  size_t size;
+};
+
+namespace detail
+{
+
+struct tagged_order
+{
+  const tagged_sequence *sequences;
+
+  bool operator()(size_t a, size_t b) const
+  {
+    return sequences[a].tag < sequences[b].tag || (sequences[a].tag == sequences[b].tag && sequences[a].size < sequences[b].size);
+  }
+};
+
+typedef column_kernel (*kernel_plan)(kernel_planner &planner, const std::string &scheme, size_t width);
+
+template <typename Features, typename Precheck>
+column_kernel plan_kernel(kernel_planner &planner, const std::string &scheme, size_t width)
+{
+  return planner.template plan<Features, Precheck>(scheme, width);
+}
+
+// The kernel of a registered scheme, or its plan and its name in the plans if it is planned.
+struct scheduled_scheme
+{
+  column_kernel kernel;
+  kernel_plan plan;
+  std::string name;
+};
+
+} // namespace detail
+
+/*! \class batch_scheduler
+    \brief Dispatch the buckets of a mixed batch to the validation of their scheme.
+
+    The schemes are registered with a tag, then any number of batches can be validated.
+*/
+class batch_scheduler
+{
+  kernel_planner *planner;
+  std::vector<detail::scheduled_scheme> schemes;
+
+  std::vector<size_t> order;
+  std::vector<char> column;
+  std::vector<bitmap_word> bitmap;
+
+  void check_bucket(const tagged_sequence *sequences, const size_t *first, const size_t *last, bool *valid)
+  {
+    const tagged_sequence &head = sequences[*first];
+    size_t length = last - first;
+    column_kernel kernel = 0;
+    if(head.tag < schemes.size())
+    {
+      const detail::scheduled_scheme &scheme = schemes[head.tag];
+      kernel = scheme.plan ? scheme.plan(*planner, scheme.name, head.size) : scheme.kernel;
+    }
+    if(kernel == 0)
+    {
+      for(; first != last; ++first)
+        valid[*first] = false;
+      return;
+    }
+
+    column.resize(length * head.size + 1);
+    for(size_t r = 0; r < length; ++r)
+      std::copy(sequences[first[r]].data, sequences[first[r]].data + head.size, column.begin() + r * head.size);
+    bitmap.resize(bitmap_size(length));
+    kernel(&column[0], head.size, length, 0, &bitmap[0]);
+    for(size_t r = 0; r < length; ++r)
+      valid[first[r]] = bitmap_test(&bitmap[0], r);
+  }
+
+public:
+  /*!
+    \brief A scheduler validating the buckets with check_fixed_column.
+  */
+  batch_scheduler() : planner(0)
+  {}
+
+  /*!
+    \brief A scheduler validating the buckets of the schemes registered with a name by the kernels planned by planner.
+
+    \param planner plans the kernels, it must outlive the scheduler.
+  */
+  explicit batch_scheduler(kernel_planner &planner) : planner(&planner)
+  {}
+
+  /*!
+    \brief Register a scheme.
+
+    \tparam Features is the features type of the scheme.
+    \tparam Precheck is the precheck applied on its sequences (for example digit).
+    \param tag is the tag of the scheme in the batches, a small integer.
+    \param scheme is the name of the scheme in the plans. If it is empty or if the scheduler has no planner,
+    the buckets of the scheme are validated by check_fixed_column.
+  */
+  template <typename Features, typename Precheck>
+  void add(size_t tag, const std::string &scheme = std::string())
+  {
+    detail::scheduled_scheme unregistered = { 0, 0, std::string() };
+    if(tag >= schemes.size())
+      schemes.resize(tag + 1, unregistered);
+    detail::scheduled_scheme registered = { &check_fixed_column<Features, Precheck>, 0, scheme };
+    if(planner && !scheme.empty())
+      registered.plan = &detail::plan_kernel<Features, Precheck>;
+    schemes[tag] = registered;
+  }
+
+  /*!
+    \brief Validate a batch of tagged sequences.
+
+    \param sequences are the sequences.
+    \param count is the number of sequences.
+    \param valid receives the result of each sequence, in the input order. A sequence whose tag is not registered is not valid.
+
+    \returns The number of valid sequences.
+  */
+  size_t check(const tagged_sequence *sequences, size_t count, bool *valid)
+  {
+    order.resize(count);
+    for(size_t i = 0; i < count; ++i)
+      order[i] = i;
+    detail::tagged_order by_bucket = { sequences };
+    std::stable_sort(order.begin(), order.end(), by_bucket);
+
+    for(size_t first = 0; first < count;)
+    {
+      size_t last = first + 1;
+      while(last < count && !by_bucket(order[first], order[last]))
+        ++last;
+      check_bucket(sequences, &order[first], &order[0] + last, valid);
+      first = last;
+    }
+
+    size_t valid_count = 0;
+    for(size_t i = 0; i < count; ++i)
+      valid_count += valid[i];
+    return valid_count;
+  }
+};
+
+}} // namespace boost   namespace checkdigit
+#endif // BOOST_CHECKDIGIT_BATCH_SCHEDULER_HPP
@@ -0,0 +1,173 @@
+//  Boost checks/checked_id.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief Provides a sequence keeping its checksum up to date when its digits are modified.
+
+    \details For the processors whose checksum is a sum of independent contributions (Luhn, weighted sums, modulus 97-10),
+    replacing a digit subtracts its contribution and adds the new one. The Verhoeff checksum is not a sum, so the checksums
+    of the prefixes of the traversal are kept and only the ones following the modified position are recomputed.
+*/
+
+#ifndef BOOST_CHECKDIGIT_CHECKED_ID_HPP
+#define BOOST_CHECKDIGIT_CHECKED_ID_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+#include <vector>
+#include <boost/range.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <boost/checkdigit/traversal.hpp>
+#include <boost/checkdigit/precheck.hpp>
+#include <boost/checkdigit/detail/digit_kernel.hpp>
+
+namespace boost {
+    namespace checkdigit{
+
+/*! \class checked_id
+    \brief A sequence of values whose checksum is updated when a value is replaced or two values are swapped.
+
+    \tparam Features is the features type of the sequence.
+    \tparam Precheck is the precheck used to read the sequence.
+
+    \remarks The indexes are the indexes of the values from the left of the sequence, after the precheck (the separators are not counted).
+*/
+template <typename Features, typename Precheck = digit>
+class checked_id
+{
+  typedef typename Features::checksum::processor processor;
+  typedef checksum_contribution<processor> contribution;
+
+  std::vector<size_t> values;
+  // For an additive processor, sums[0] is the checksum. Otherwise sums[k] is the checksum of the first k values in the traversal order.
+  std::vector<size_t> sums;
+
+  size_t position(size_t index) const
+  {
+    return boost::is_base_of<forward_traversal, Features>::value ? index : values.size() - 1 - index;
+  }
+
+  void recompute(size_t from)
+  {
+    processor process;
+    for(size_t pos = from; pos < values.size(); ++pos)
+      sums[pos + 1] = process(sums[pos], values[position(pos)], pos);
+  }
+
+  size_t contribution_at(size_t index) const
+  {
+    return contribution_at(index, boost::integral_constant<bool, contribution::additive>());
+  }
+
+  size_t contribution_at(size_t index, boost::true_type) const
+  {
+    return contribution::at(values[index], position(index));
+  }
+
+  size_t contribution_at(size_t, boost::false_type) const
+  {
+    return 0;
+  }
+
+  void update(size_t index, size_t value, boost::true_type)
+  {
+    size_t pos = position(index);
+    sums[0] = sums[0] - contribution::at(values[index], pos) + contribution::at(value, pos);
+    values[index] = value;
+  }
+
+  void update(size_t index, size_t value, boost::false_type)
+  {
+    values[index] = value;
+    recompute(position(index));
+  }
+
+public:
+  /*!
+    \brief Read the values of the sequence and compute its checksum.
+
+    \param x is the sequence.
+  */
+  template <typename Range>
+  explicit checked_id(const Range &x)
+  {
+    std::pair<typename Precheck::template iterator<typename boost::range_iterator<const Range>::type>::type,
+              typename Precheck::template iterator<typename boost::range_iterator<const Range>::type>::type>
+      checked = make_precheck<Precheck>(boost::begin(x), boost::end(x));
+    values.assign(checked.first, checked.second);
+
+    if(contribution::additive)
+    {
+      sums.assign(1, 0);
+      for(size_t index = 0; index < values.size(); ++index)
+        sums[0] += contribution_at(index);
+    }
+    else
+    {
+      sums.assign(values.size() + 1, 0);
+      recompute(0);
+    }
+  }
+
+  //! The number of values of the sequence.
+  size_t size() const
+  {
+    return values.size();
+  }
+
+  //! The value at the index.
+  size_t operator[](size_t index) const
+  {
+    return values[index];
+  }
+
+  //! The checksum of the sequence.
+  size_t checksum() const
+  {
+    return contribution::additive ? sums[0] : sums.back();
+  }
+
+  /*!
+    \brief Replace the value at an index.
+
+    \remarks Constant time for an additive processor, proportional to the number of values following the position in the traversal otherwise.
+  */
+  void replace(size_t index, size_t value)
+  {
+    update(index, value, boost::integral_constant<bool, contribution::additive>());
+  }
+
+  /*!
+    \brief Swap the values at two indexes.
+  */
+  void swap(size_t i, size_t j)
+  {
+    size_t value_i = values[i];
+    replace(i, values[j]);
+    replace(j, value_i);
+  }
+
+  /*!
+    \brief Validate the sequence.
+
+    \returns @c true if the size of the sequence is correct and the checksum is valid, @c false otherwise.
+  */
+  bool valid() const
+  {
+    if(values.empty() || Features::size_policy::overflow(values.size()))
+      return false;
+    return typename Features::checksum::validate_checkdigit()(checksum());
+  }
+};
+
+}} // namespace boost   namespace checkdigit
+#endif // BOOST_CHECKDIGIT_CHECKED_ID_HPP
@@ -61,13 +61,14 @@ and C++ include files are in folder:
 #include <boost/checkdigit/luhn.hpp>
 #include <boost/checkdigit/verhoeff.hpp>
 #include <boost/checkdigit/modulus11.hpp>
-#include <boost/checkdigit/modulus97.hpp>
+#include <boost/checkdigit/modulus97_10.hpp>
 #include <boost/checkdigit/ean.hpp>
 #include <boost/checkdigit/isbn.hpp>
 #include <boost/checkdigit/upc.hpp>
 #include <boost/checkdigit/amex.hpp>
 #include <boost/checkdigit/visa.hpp>
 #include <boost/checkdigit/mastercard.hpp>
+#include <boost/checkdigit/gs1.hpp>
 
 namespace boost{
   namespace checkdigit{
@@ -212,6 +213,42 @@ template <typename check_range>
 size_t compute_mastercard(const check_range& x);
 size_t compute_mastercard(const std::string& x);
 
+// GS1 keys: GTIN-14, SSCC, GLN and GSIN
+
+template <typename check_range>
+bool check_gtin14(const check_range& x);
+bool check_gtin14(const std::string& x);
+
+template <typename check_range>
+size_t compute_gtin14(const check_range& x);
+size_t compute_gtin14(const std::string& x);
+
+template <typename check_range>
+bool check_sscc(const check_range& x);
+bool check_sscc(const std::string& x);
+
+template <typename check_range>
+size_t compute_sscc(const check_range& x);
+size_t compute_sscc(const std::string& x);
+
+template <typename check_range>
+bool check_gln(const check_range& x);
+bool check_gln(const std::string& x);
+
+template <typename check_range>
+size_t compute_gln(const check_range& x);
+size_t compute_gln(const std::string& x);
+
+template <typename check_range>
+bool check_gsin(const check_range& x);
+bool check_gsin(const std::string& x);
+
+template <typename check_range>
+size_t compute_gsin(const check_range& x);
+size_t compute_gsin(const std::string& x);
+
+bool check_gs1_element_string(const char *first, const char *last);
+bool check_gs1_element_string(const std::string& x);
 
 }} // namespace boost   namespace checkdigit
 #endif // BOOST_CHECKDIGIT_CHECKS_FWD_HPP
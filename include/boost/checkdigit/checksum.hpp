@@ -16,11 +16,57 @@
     #pragma once
 #endif
 
+#include <cstddef> // size_t
 #include <boost/checkdigit/checkdigit.hpp>
+#include <boost/checkdigit/traversal.hpp>
 
 namespace boost {
   namespace checkdigit{
 
+/*!
+  \brief The check digit is a single value at the position 0 of the traversal (the last value of the sequence for a reverse traversal).
+*/
+struct basic_checkdigit
+{
+  static const size_t pos = 0;
+  static const size_t size = 1;
+};
+
+/*!
+  \brief The sequence must contain exactly size_expected values.
+*/
+template <size_t size_expected>
+struct enforce_size_policy
+{
+  //! @c true if a value can follow the counter values.
+  static bool check(size_t counter)
+  {
+    return counter < size_expected;
+  }
+
+  //! @c true if a sequence of counter values doesn't have the expected size.
+  static bool overflow(size_t counter)
+  {
+    return counter != size_expected;
+  }
+};
+
+/*!
+  \brief The sequence can contain any number of values.
+*/
+struct no_size_policy
+{
+  static bool check(size_t)
+  {
+    return true;
+  }
+
+  static bool overflow(size_t)
+  {
+    return false;
+  }
+};
+
 template
 <
   typename TernaryFunction,
@@ -46,6 +92,7 @@ struct features : Checksum
 {
   typedef Checksum checksum;
   typedef enforce_size_policy<size_expected> size_policy;
+  static const size_t size = size_expected;
 };
 
 template
@@ -56,6 +103,7 @@ struct features<Checksum, 0> : Checksum
 {
   typedef Checksum checksum;
   typedef no_size_policy size_policy;
+  static const size_t size = 0;
 };
 
 
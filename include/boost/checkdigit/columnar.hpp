@@ -0,0 +1,249 @@
+//  Boost checks/columnar.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief Validate the string columns of a columnar format (as Apache Arrow) in place.
+
+    \details A column of variable size is a data buffer and an offsets array of length + 1 entries, the row i being
+    the characters [offsets[i], offsets[i + 1]) of the buffer. A column of fixed size is a data buffer of rows of width
+    characters. The validity bitmap has a bit per row, the bit i % 8 of the byte i / 8 being set if the row i is not null.
+    The results are written into a bitmap of bitmap_word (the same bit order on a little-endian machine): a bit is set
+    if the row is not null and valid. A null row is neither valid nor failing.
+
+    The fixed size columns of digits are validated by batches of BOOST_CHECKDIGIT_COLUMN_BATCH rows: the outer loop
+    runs on the positions and the inner loop on the rows, which can be vectorized. A row containing a character that
+    is not a digit is validated again with the precheck, as a row of a variable size column.
+*/
+
+#ifndef BOOST_CHECKDIGIT_COLUMNAR_HPP
+#define BOOST_CHECKDIGIT_COLUMNAR_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+#include <boost/cstdint.hpp>
+#include <boost/type_traits/is_same.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <boost/checkdigit/basic_checks.hpp>
+#include <boost/checkdigit/precheck.hpp>
+#include <boost/checkdigit/traversal.hpp>
+#include <boost/checkdigit/detail/digit_kernel.hpp>
+#include <boost/checkdigit/parallel.hpp>
+
+/*!
+  \brief This macro defines the number of rows of a batch of the fixed size columns, a bitmap word.
+*/
+#define BOOST_CHECKDIGIT_COLUMN_BATCH 64
+
+namespace boost {
+    namespace checkdigit{
+
+namespace detail
+{
+
+inline bool column_valid(const boost::uint8_t *validity, size_t i)
+{
+  return validity == 0 || ((validity[i / 8] >> (i % 8)) & 1);
+}
+
+// Write the results of the rows of a batch and append the failing rows to the selection vector.
+inline boost::uint32_t *store_column_batch(bitmap_word bits, const boost::uint8_t *validity, size_t first, size_t count,
+                                           bitmap_word *bitmap, boost::uint32_t *failures)
+{
+  bitmap[first / 64] = bits;
+  if(failures)
+  {
+    for(size_t r = 0; r < count; ++r)
+      if(!((bits >> r) & 1) && column_valid(validity, first + r))
+        *failures++ = static_cast<boost::uint32_t>(first + r);
+  }
+  return failures;
+}
+
+template <typename Features, typename Precheck>
+bool check_row(const char *row, size_t size)
+{
+  return check_sequence<Features>(make_precheck<Precheck>(row, row + size));
+}
+
+template <typename Features, typename Precheck, typename Offset>
+boost::uint32_t *check_column(const char *data, const Offset *offsets, size_t length, const boost::uint8_t *validity,
+                              bitmap_word *bitmap, boost::uint32_t *failures)
+{
+  for(size_t first = 0; first < length; first += 64)
+  {
+    size_t count = length - first < 64 ? length - first : 64;
+    bitmap_word bits = 0;
+    for(size_t r = 0; r < count; ++r)
+    {
+      size_t i = first + r;
+      if(column_valid(validity, i))
+        bits |= bitmap_word(check_row<Features, Precheck>(data + offsets[i], static_cast<size_t>(offsets[i + 1] - offsets[i]))) << r;
+    }
+    failures = store_column_batch(bits, validity, first, count, bitmap, failures);
+  }
+  return failures;
+}
+
+template <typename Features, typename Precheck>
+struct fixed_column
+{
+  // Additive processor on digits, each row being the whole sequence.
+  typedef boost::integral_constant<bool,
+    checksum_contribution<typename Features::checksum::processor>::additive &&
+    boost::is_base_of<reverse_traversal, Features>::value &&
+    (boost::is_same<Precheck, digit>::value || boost::is_same<Precheck, digitx>::value)> fast;
+
+  static bitmap_word batch(const char *rows, size_t width, size_t count, boost::true_type)
+  {
+    if(width == 0 || (Features::size != 0 && Features::size != width))
+      return batch(rows, width, count, boost::false_type());
+
+    size_t checksums[BOOST_CHECKDIGIT_COLUMN_BATCH] = { 0 };
+    unsigned char other[BOOST_CHECKDIGIT_COLUMN_BATCH] = { 0 };
+    character_digits digits = { rows + width - 1, width };
+    additive_checksums<typename Features::checksum::processor>(digits, width, 0, count, checksums, other);
+    bitmap_word bits = 0;
+    for(size_t r = 0; r < count; ++r)
+    {
+      bool valid = other[r] ? check_row<Features, Precheck>(rows + r * width, width)
+                            : typename Features::checksum::validate_checkdigit()(checksums[r]);
+      bits |= bitmap_word(valid) << r;
+    }
+    return bits;
+  }
+
+  static bitmap_word batch(const char *rows, size_t width, size_t count, boost::false_type)
+  {
+    bitmap_word bits = 0;
+    for(size_t r = 0; r < count; ++r)
+      bits |= bitmap_word(check_row<Features, Precheck>(rows + r * width, width)) << r;
+    return bits;
+  }
+
+  static boost::uint32_t *check(const char *data, size_t width, size_t length, const boost::uint8_t *validity,
+                                bitmap_word *bitmap, boost::uint32_t *failures)
+  {
+    return check(data, width, length, validity, bitmap, failures, fast());
+  }
+
+  // The batch path (true_type) or a row after the other (false_type).
+  template <typename Path>
+  static boost::uint32_t *check(const char *data, size_t width, size_t length, const boost::uint8_t *validity,
+                                bitmap_word *bitmap, boost::uint32_t *failures, Path path)
+  {
+    for(size_t first = 0; first < length; first += BOOST_CHECKDIGIT_COLUMN_BATCH)
+    {
+      size_t count = length - first < BOOST_CHECKDIGIT_COLUMN_BATCH ? length - first : BOOST_CHECKDIGIT_COLUMN_BATCH;
+      bitmap_word bits = batch(data + first * width, width, count, path);
+      // The null rows are computed with the others (their slot holds some characters), then masked.
+      if(validity)
+      {
+        bitmap_word mask = 0;
+        for(size_t r = 0; r < count; ++r)
+          mask |= bitmap_word(column_valid(validity, first + r)) << r;
+        bits &= mask;
+      }
+      failures = store_column_batch(bits, validity, first, count, bitmap, failures);
+    }
+    return failures;
+  }
+};
+
+inline size_t bitmap_count(const bitmap_word *bitmap, size_t length)
+{
+  size_t valid = 0;
+  for(size_t i = 0; i < bitmap_size(length); ++i)
+    for(bitmap_word w = bitmap[i]; w != 0; w &= w - 1)
+      ++valid;
+  return valid;
+}
+
+} // namespace detail
+
+/*!
+    \brief Validate a column of variable size sequences.
+
+    \tparam Features is the features type of the sequences.
+    \tparam Precheck is the precheck applied on each row (for example digit).
+    \tparam Offset is the type of the offsets (boost::int32_t or boost::int64_t).
+    \param data is the data buffer.
+    \param offsets has length + 1 entries, the row i being [data + offsets[i], data + offsets[i + 1]).
+    \param length is the number of rows.
+    \param validity is the validity bitmap of the rows, 0 if no row is null.
+    \param bitmap receives the results, it must hold bitmap_size(length) words.
+
+    \returns The number of valid rows.
+*/
+template <typename Features, typename Precheck, typename Offset>
+size_t check_column(const char *data, const Offset *offsets, size_t length, const boost::uint8_t *validity, bitmap_word *bitmap)
+{
+  detail::check_column<Features, Precheck>(data, offsets, length, validity, bitmap, static_cast<boost::uint32_t*>(0));
+  return detail::bitmap_count(bitmap, length);
+}
+
+/*!
+    \brief Validate a column of variable size sequences and list the failing rows.
+
+    \param failures receives the selection vector of the rows neither null nor valid, by increasing index. It must hold length entries.
+    The other parameters are the ones of the overload without selection vector.
+
+    \returns The number of failing rows written into failures.
+*/
+template <typename Features, typename Precheck, typename Offset>
+size_t check_column(const char *data, const Offset *offsets, size_t length, const boost::uint8_t *validity, bitmap_word *bitmap,
+                    boost::uint32_t *failures)
+{
+  return detail::check_column<Features, Precheck>(data, offsets, length, validity, bitmap, failures) - failures;
+}
+
+/*!
+  \brief The validation of a fixed size column, as check_fixed_column.
+*/
+typedef size_t (*column_kernel)(const char *data, size_t width, size_t length, const boost::uint8_t *validity, bitmap_word *bitmap);
+
+/*!
+    \brief Validate a column of fixed size sequences.
+
+    \tparam Features is the features type of the sequences.
+    \tparam Precheck is the precheck applied on each row. With digit or digitx, the rows of digits take the batch path.
+    \param data is the data buffer, the row i being [data + i * width, data + (i + 1) * width).
+    \param width is the number of characters of a row.
+    \param length is the number of rows.
+    \param validity is the validity bitmap of the rows, 0 if no row is null.
+    \param bitmap receives the results, it must hold bitmap_size(length) words.
+
+    \returns The number of valid rows.
+*/
+template <typename Features, typename Precheck>
+size_t check_fixed_column(const char *data, size_t width, size_t length, const boost::uint8_t *validity, bitmap_word *bitmap)
+{
+  detail::fixed_column<Features, Precheck>::check(data, width, length, validity, bitmap, static_cast<boost::uint32_t*>(0));
+  return detail::bitmap_count(bitmap, length);
+}
+
+/*!
+    \brief Validate a column of fixed size sequences and list the failing rows.
+
+    \param failures receives the selection vector of the rows neither null nor valid, by increasing index. It must hold length entries.
+    The other parameters are the ones of the overload without selection vector.
+
+    \returns The number of failing rows written into failures.
+*/
+template <typename Features, typename Precheck>
+size_t check_fixed_column(const char *data, size_t width, size_t length, const boost::uint8_t *validity, bitmap_word *bitmap,
+                          boost::uint32_t *failures)
+{
+  return detail::fixed_column<Features, Precheck>::check(data, width, length, validity, bitmap, failures) - failures;
+}
+
+}} // namespace boost   namespace checkdigit
+#endif // BOOST_CHECKDIGIT_COLUMNAR_HPP
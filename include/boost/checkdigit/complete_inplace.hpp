@@ -0,0 +1,146 @@
+//  Boost checks/complete_inplace.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief Write the check digits of the fields of fixed-width records directly into the records.
+
+    \details The field of each record is Features::size characters long: the payload digits followed by the slot of the
+    check digit(s). For the processors whose checksum is a sum of contributions, the records are processed by batches of
+    BOOST_CHECKDIGIT_INPLACE_BATCH: the outer loop runs on the positions and the inner loop on the records of the batch,
+    so the inner loop has no dependency between its iterations and can be vectorized.
+*/
+
+#ifndef BOOST_CHECKDIGIT_COMPLETE_INPLACE_HPP
+#define BOOST_CHECKDIGIT_COMPLETE_INPLACE_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <boost/checkdigit/traversal.hpp>
+#include <boost/checkdigit/detail/digit_kernel.hpp>
+
+/*!
+  \brief This macro defines the number of records whose checksums are computed together by complete_inplace.
+*/
+#define BOOST_CHECKDIGIT_INPLACE_BATCH 64
+
+namespace boost {
+    namespace checkdigit{
+
+namespace detail
+{
+
+template <typename Features>
+struct inplace_field
+{
+  BOOST_STATIC_ASSERT((boost::is_base_of<reverse_traversal, Features>::value));
+  BOOST_STATIC_ASSERT(Features::checksum::checkdigit_detail::pos == 0);
+  BOOST_STATIC_ASSERT(Features::size > Features::checksum::checkdigit_detail::size);
+
+  static const size_t checkdigit_size = Features::checksum::checkdigit_detail::size;
+  static const size_t payload_size = Features::size - checkdigit_size;
+
+  // Write the check digit of the checksum into the slot, 'X' for 10 if the slot has a single character.
+  static void write(char *slot, size_t checksum)
+  {
+    size_t checkdigit = typename Features::checksum::make_checkdigit()(checksum);
+    if(checkdigit_size == 1 && checkdigit == 10)
+      *slot = 'X';
+    else
+    {
+      for(size_t i = checkdigit_size; i-- > 0; checkdigit /= 10)
+        slot[i] = static_cast<char>('0' + checkdigit % 10);
+    }
+  }
+
+  // Additive processor: the positions in the outer loop, the records of the batch in the inner loop.
+  static size_t batch(char *records, size_t stride, size_t count, boost::true_type)
+  {
+    size_t checksums[BOOST_CHECKDIGIT_INPLACE_BATCH] = { 0 };
+    unsigned char invalid[BOOST_CHECKDIGIT_INPLACE_BATCH] = { 0 };
+    character_digits digits = { records + payload_size - 1, stride };
+    additive_checksums<typename Features::checksum::processor>(digits, payload_size, checkdigit_size, count, checksums, invalid);
+    size_t completed = 0;
+    for(size_t r = 0; r < count; ++r)
+    {
+      if(!invalid[r])
+      {
+        write(records + r * stride + payload_size, checksums[r]);
+        ++completed;
+      }
+    }
+    return completed;
+  }
+
+  // Other processors (Verhoeff): one record after the other.
+  static size_t batch(char *records, size_t stride, size_t count, boost::false_type)
+  {
+    size_t completed = 0;
+    for(size_t r = 0; r < count; ++r)
+    {
+      char *field = records + r * stride;
+      typename Features::checksum::processor process;
+      size_t checksum = 0;
+      bool valid = true;
+      for(size_t k = 0; k < payload_size; ++k)
+      {
+        size_t value = static_cast<unsigned char>(field[payload_size - 1 - k]) - '0';
+        // A value out of the tables of the processor is never processed.
+        if(value > 9)
+        {
+          valid = false;
+          break;
+        }
+        checksum = process(checksum, value, k + checkdigit_size);
+      }
+      if(valid)
+      {
+        write(field + payload_size, checksum);
+        ++completed;
+      }
+    }
+    return completed;
+  }
+};
+
+} // namespace detail
+
+/*!
+    \brief Compute the check digits of the fields of fixed-width records and write them into the records.
+
+    \tparam Features is the features type of the field, with a size, a reverse traversal and the check digit(s) at the end.
+    \param records is the first record.
+    \param stride is the number of characters between the beginnings of two records.
+    \param field_offset is the offset of the field in a record. The field has Features::size characters: the payload
+    digits, then the slot of the check digit(s).
+    \param count is the number of records.
+
+    \returns The number of completed records. The slot of a field whose payload contains a character that is not a digit is left untouched.
+*/
+template <typename Features>
+size_t complete_inplace(char *records, size_t stride, size_t field_offset, size_t count)
+{
+  typedef detail::inplace_field<Features> field;
+  typedef boost::integral_constant<bool, checksum_contribution<typename Features::checksum::processor>::additive> additive;
+
+  size_t completed = 0;
+  for(size_t first = 0; first < count; first += BOOST_CHECKDIGIT_INPLACE_BATCH)
+  {
+    size_t n = count - first < BOOST_CHECKDIGIT_INPLACE_BATCH ? count - first : BOOST_CHECKDIGIT_INPLACE_BATCH;
+    completed += field::batch(records + first * stride + field_offset, stride, n, additive());
+  }
+  return completed;
+}
+
+}} // namespace boost   namespace checkdigit
+#endif // BOOST_CHECKDIGIT_COMPLETE_INPLACE_HPP
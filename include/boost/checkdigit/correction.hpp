@@ -0,0 +1,266 @@
+//  Boost checks/correction.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief Find the corrections making an invalid sequence valid.
+
+    \details The corrections are the single substitutions, the adjacent transpositions (ab -> ba), the jump
+    transpositions (abc -> cba) and, if the sequence contains one or two unknown values marked with '?', the values
+    of the unknown positions. The partial checksums of every prefix and every suffix of the traversal are computed once,
+    then the checksum of a candidate is the combination of a prefix, of the one to three modified values and of a suffix,
+    so the cost of a candidate does not depend on the size of the sequence.
+*/
+
+#ifndef BOOST_CHECKDIGIT_CORRECTION_HPP
+#define BOOST_CHECKDIGIT_CORRECTION_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+#include <vector>
+#include <algorithm>
+#include <boost/range.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+
+#include <boost/checkdigit/traversal.hpp>
+#include <boost/checkdigit/precheck.hpp>
+#include <boost/checkdigit/partial_checksum.hpp>
+
+/*!
+  \brief This macro defines the character marking an unknown value.
+*/
+#define BOOST_CHECKDIGIT_UNKNOWN_VALUE '?'
+
+namespace boost {
+    namespace checkdigit{
+
+/*!
+  \brief The kinds of corrections.
+*/
+enum correction_kind
+{
+  substitution,
+  adjacent_transposition,
+  jump_transposition,
+  erasure
+};
+
+/*!
+  \brief A correction of a sequence. The indexes are the indexes of the values from the left, after the precheck.
+*/
+struct correction
+{
+  correction_kind kind;
+  //! The index of the substituted value, the first of the two transposed values or of the unknown values.
+  size_t first;
+  //! The index of the second transposed or unknown value, first otherwise.
+  size_t second;
+  //! The value at the index first after the correction.
+  size_t first_value;
+  //! The value at the index second after the correction.
+  size_t second_value;
+};
+
+namespace detail
+{
+
+template <typename Features>
+class correction_finder
+{
+  typedef partial_checksum<typename Features::checksum::processor> partial;
+  typedef typename partial::state state;
+
+  const std::vector<size_t> &values; // In the traversal order.
+  std::vector<state> prefixes;       // prefixes[k] is the state of the values [0, k).
+  std::vector<state> suffixes;       // suffixes[k] is the state of the values [k, n).
+  size_t max_checkdigit;             // The maximal value at the position 0 (10 if 'X' is accepted).
+
+  bool valid(const state &s) const
+  {
+    return typename Features::checksum::validate_checkdigit()(partial::checksum(s));
+  }
+
+  // The state of the values, with the values [first, first + middle_size) replaced by middle.
+  state candidate(size_t first, const size_t *middle, size_t middle_size) const
+  {
+    state s = prefixes[first];
+    state m = partial::empty();
+    for(size_t i = 0; i < middle_size; ++i)
+      partial::push(m, middle[i]);
+    return partial::combine(partial::combine(s, m), suffixes[first + middle_size]);
+  }
+
+  size_t max_value(size_t pos) const
+  {
+    return pos == 0 ? max_checkdigit : 9;
+  }
+
+  // True if every value of middle is allowed at its position, starting at first.
+  bool fits(size_t first, const size_t *middle, size_t middle_size) const
+  {
+    for(size_t k = 0; k < middle_size; ++k)
+      if(middle[k] > max_value(first + k))
+        return false;
+    return true;
+  }
+
+public:
+  correction_finder(const std::vector<size_t> &values, size_t max_checkdigit)
+  : values(values), prefixes(values.size() + 1), suffixes(values.size() + 1), max_checkdigit(max_checkdigit)
+  {
+    size_t n = values.size();
+    prefixes[0] = partial::empty();
+    for(size_t k = 0; k < n; ++k)
+    {
+      prefixes[k + 1] = prefixes[k];
+      partial::push(prefixes[k + 1], values[k]);
+    }
+    suffixes[n] = partial::empty();
+    for(size_t k = n; k-- > 0;)
+    {
+      state single = partial::empty();
+      partial::push(single, values[k]);
+      suffixes[k] = partial::combine(single, suffixes[k + 1]);
+    }
+  }
+
+  // Call report(kind, pos1, pos2, value1, value2) for each valid candidate, the positions in the traversal order.
+  template <typename Report>
+  void edits(Report &report) const
+  {
+    size_t n = values.size();
+    for(size_t pos = 0; pos < n; ++pos)
+    {
+      for(size_t value = 0; value <= max_value(pos); ++value)
+        if(value != values[pos] && valid(candidate(pos, &value, 1)))
+          report(substitution, pos, pos, value, value);
+    }
+    for(size_t pos = 0; pos + 1 < n; ++pos)
+    {
+      size_t middle[2] = { values[pos + 1], values[pos] };
+      if(middle[0] != middle[1] && fits(pos, middle, 2) && valid(candidate(pos, middle, 2)))
+        report(adjacent_transposition, pos, pos + 1, middle[0], middle[1]);
+    }
+    for(size_t pos = 0; pos + 2 < n; ++pos)
+    {
+      size_t middle[3] = { values[pos + 2], values[pos + 1], values[pos] };
+      if(middle[0] != middle[2] && fits(pos, middle, 3) && valid(candidate(pos, middle, 3)))
+        report(jump_transposition, pos, pos + 2, middle[0], middle[2]);
+    }
+  }
+
+  // Call report for each valid value of the unknown position pos, or of the unknown positions pos and pos2 (pos < pos2).
+  template <typename Report>
+  void erasures(size_t pos, size_t pos2, bool two_unknowns, Report &report) const
+  {
+    if(!two_unknowns)
+    {
+      for(size_t value = 0; value <= max_value(pos); ++value)
+        if(valid(candidate(pos, &value, 1)))
+          report(erasure, pos, pos, value, value);
+      return;
+    }
+
+    // The values between the two unknown positions are combined once.
+    state between = partial::empty();
+    for(size_t k = pos + 1; k < pos2; ++k)
+      partial::push(between, values[k]);
+    for(size_t value = 0; value <= max_value(pos); ++value)
+    {
+      state s = prefixes[pos];
+      partial::push(s, value);
+      s = partial::combine(s, between);
+      for(size_t value2 = 0; value2 <= 9; ++value2)
+      {
+        state t = partial::empty();
+        partial::push(t, value2);
+        if(valid(partial::combine(partial::combine(s, t), suffixes[pos2 + 1])))
+          report(erasure, pos, pos2, value, value2);
+      }
+    }
+  }
+};
+
+// Translate the positions of the traversal order into indexes from the left and write the correction.
+template <typename OutputIterator>
+struct correction_writer
+{
+  OutputIterator &out;
+  size_t size;
+  bool forward;
+
+  void operator()(correction_kind kind, size_t pos1, size_t pos2, size_t value1, size_t value2)
+  {
+    correction c = { kind, pos1, pos2, value1, value2 };
+    if(!forward)
+    {
+      c.first = size - 1 - pos2;
+      c.second = size - 1 - pos1;
+      c.first_value = value2;
+      c.second_value = value1;
+    }
+    *out++ = c;
+  }
+};
+
+} // namespace detail
+
+/*!
+    \brief Find the corrections making a sequence valid.
+
+    \tparam Features is the features type of the sequence, partial_checksum must be specialized for its processor.
+    \tparam Precheck is the precheck of the sequence.
+    \tparam OutputIterator must accept correction values.
+    \param x is the sequence. If it contains one or two '?', only the values of these unknown positions are searched.
+    \param out receives the corrections.
+
+    \returns The output iterator after the last correction written. No correction is written if the size of the
+    sequence is incorrect or if there are more than two unknown values.
+*/
+template <typename Features, typename Precheck, typename Range, typename OutputIterator>
+OutputIterator find_corrections(const Range &x, OutputIterator out)
+{
+  typename Precheck::FilterPredicate filter;
+  typename Precheck::ConversionFunction convert;
+
+  std::vector<size_t> values;
+  std::vector<size_t> unknowns;
+  for(typename boost::range_iterator<const Range>::type it = boost::begin(x); it != boost::end(x); ++it)
+  {
+    if(*it == BOOST_CHECKDIGIT_UNKNOWN_VALUE)
+    {
+      unknowns.push_back(values.size());
+      values.push_back(0);
+    }
+    else if(filter(*it))
+      values.push_back(convert(*it));
+  }
+  size_t n = values.size();
+  if(n == 0 || Features::size_policy::overflow(n) || unknowns.size() > 2)
+    return out;
+
+  bool forward = boost::is_base_of<forward_traversal, Features>::value;
+  if(!forward)
+    std::reverse(values.begin(), values.end());
+
+  detail::correction_finder<Features> finder(values, filter('X') ? 10 : 9);
+  detail::correction_writer<OutputIterator> writer = { out, n, forward };
+  if(unknowns.empty())
+    finder.edits(writer);
+  else
+  {
+    size_t pos1 = forward ? unknowns.front() : n - 1 - unknowns.back();
+    size_t pos2 = forward ? unknowns.back() : n - 1 - unknowns.front();
+    finder.erasures(pos1, pos2, unknowns.size() == 2, writer);
+  }
+  return out;
+}
+
+}} // namespace boost   namespace checkdigit
+#endif // BOOST_CHECKDIGIT_CORRECTION_HPP
@@ -0,0 +1,194 @@
+//  Boost checks/digit_kernel.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief Kernels computing checksums over contiguous ASCII digits.
+
+    \details The processors consume one value at a time through iterators. These kernels
+    compute the same checksums on a contiguous buffer of known size, without branching
+    on the values, so the compiler can vectorize them. The checksums of the additive
+    processors are also computed on batches of sequences, one position at a time.
+*/
+
+#ifndef BOOST_CHECKDIGIT_DETAIL_DIGIT_KERNEL_HPP
+#define BOOST_CHECKDIGIT_DETAIL_DIGIT_KERNEL_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+#include <boost/checkdigit/basic_checks.hpp>
+#include <boost/checkdigit/weighted_sum.hpp>
+#include <boost/checkdigit/positional_weight.hpp>
+#include <boost/checkdigit/verhoeff.hpp>
+#include <boost/checkdigit/modulus97_10.hpp>
+
+namespace boost{
+  namespace checkdigit{
+
+/*!
+  \brief The contribution of a value at a position to the checksum of Processor, if the checksum is a sum of contributions.
+
+  \remarks By default the processor is called on a null checksum, which is correct for the processors without state.
+  The specializations with additive = false have no contribution: the checksum must be recomputed.
+*/
+template <typename Processor>
+struct checksum_contribution
+{
+  static const bool additive = true;
+
+  static size_t at(size_t value, size_t pos)
+  {
+    Processor process;
+    return process(0, value, pos);
+  }
+};
+
+template <size_t first, size_t ratio>
+struct checksum_contribution<weighted_sum<geometric_weight<first, ratio> > >
+{
+  static const bool additive = true;
+
+  static size_t at(size_t value, size_t pos)
+  {
+    return value * geometric_weight<first, ratio>::at(pos);
+  }
+};
+
+namespace detail
+{
+
+struct mod97_10_powers
+{
+  size_t values[96];
+
+  mod97_10_powers()
+  {
+    size_t power = 1;
+    for(size_t i = 0; i < 96; ++i, power = power * 10 % 97)
+      values[i] = power;
+  }
+};
+
+} // namespace detail
+
+/*!
+  \brief The contribution of a value to the modulus 97-10 checksum is value * 10^pos modulus 97, 10^pos having a period of 96.
+*/
+template <>
+struct checksum_contribution<mod97_10_processor>
+{
+  static const bool additive = true;
+
+  static size_t at(size_t value, size_t pos)
+  {
+    static const detail::mod97_10_powers powers;
+    return value * powers.values[pos % 96];
+  }
+};
+
+template <>
+struct checksum_contribution<verhoeff_processor>
+{
+  static const bool additive = false;
+};
+
+namespace detail
+{
+
+/*!
+  \brief The checksums of a batch of sequences of an additive processor, the positions in the outer loop and the
+  sequences in the inner loop, so the inner loop has no dependency between its iterations and can be vectorized.
+
+  \param digits is called as digits(r, k) for the value at the position k of the traversal of the sequence r. It must not
+  depend on the order of the calls. A value greater than 9 is not a digit: it contributes nothing and flags the sequence in other.
+  \param length is the number of positions.
+  \param first_pos is the position of the first value in the checksum (the size of the check digit to compute it).
+  \param count is the number of sequences.
+  \param checksums receives the checksums of the sequences, it must be initialized to 0.
+  \param other receives a non null flag for the sequences having a value that is not a digit, it must be initialized to 0.
+*/
+template <typename Processor, typename Digits>
+void additive_checksums(const Digits &digits, size_t length, size_t first_pos, size_t count, size_t *checksums, unsigned char *other)
+{
+  typedef checksum_contribution<Processor> contribution;
+  for(size_t k = 0; k < length; ++k)
+  {
+    for(size_t r = 0; r < count; ++r)
+    {
+      size_t value = digits(r, k);
+      other[r] |= value > 9;
+      checksums[r] += contribution::at(value > 9 ? 0 : value, k + first_pos);
+    }
+  }
+}
+
+// The digits of characters read from the end of fixed size records: last points to the last character of the first record.
+struct character_digits
+{
+  const char *last;
+  size_t stride;
+
+  size_t operator()(size_t r, size_t k) const
+  {
+    return static_cast<size_t>(static_cast<unsigned char>((last - k)[r * stride])) - '0';
+  }
+};
+
+/*!
+  \brief Compute the checksum of ean_processor (weighted_sum<weight<1,3> >) on n ASCII digits.
+
+  \param seq is the first character of the sequence.
+  \param n is the number of characters.
+  \param pos is the position of the rightmost character. The weight is 1 on even positions and 3 on odd ones.
+
+  \returns The weighted sum, or bad_sequence if a character is not a digit.
+*/
+inline size_t weight13_sum(const char *seq, size_t n, size_t pos = 0)
+{
+  size_t sum = 0;
+  unsigned int invalid = 0;
+  for(size_t i = 0; i < n; ++i)
+  {
+    unsigned int value = static_cast<unsigned char>(seq[i]) - '0';
+    invalid |= value > 9;
+    sum += value + (value << 1) * ((n - 1 - i + pos) & 1);
+  }
+  return invalid ? bad_sequence : sum;
+}
+
+/*!
+  \brief Validate n ASCII digits with the weight<1,3> modulus 10 scheme (EAN, UPC, GS1 keys).
+
+  \returns @c true if every character is a digit and the weighted sum is a multiple of 10.
+*/
+inline bool check_weight13(const char *seq, size_t n)
+{
+  size_t sum = weight13_sum(seq, n);
+  return sum != bad_sequence && sum % 10 == 0;
+}
+
+/*!
+  \brief Compute the weight<1,3> modulus 10 check digit of n ASCII digits not including the check digit.
+
+  \returns The check digit in the range [0..9], or bad_sequence if a character is not a digit.
+*/
+inline size_t compute_weight13(const char *seq, size_t n)
+{
+  // The check digit takes the position 0, so the rightmost digit is at the position 1.
+  size_t sum = weight13_sum(seq, n, 1);
+  if(sum == bad_sequence)
+    return bad_sequence;
+  return (10 - sum % 10) % 10;
+}
+
+} // namespace detail
+} // namespace checkdigit
+} // namespace boost
+
+#endif // BOOST_CHECKDIGIT_DETAIL_DIGIT_KERNEL_HPP
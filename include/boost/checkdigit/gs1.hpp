@@ -0,0 +1,440 @@
+//  Boost checks/gs1.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief This file provides tools to compute and validate the GS1 identification keys (GTIN-14, SSCC, GLN, GSIN)
+    and to parse GS1 element strings.
+
+    \remarks All the GS1 keys use the EAN weight<1,3> modulus 10 scheme, so ean types are used.
+*/
+
+#ifndef BOOST_CHECKDIGIT_GS1_HPP
+#define BOOST_CHECKDIGIT_GS1_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+#include <cstring>
+#include <string>
+
+#include <boost/checkdigit/ean.hpp>
+#include <boost/checkdigit/checksum.hpp>
+#include <boost/checkdigit/precheck.hpp>
+#include <boost/checkdigit/detail/digit_kernel.hpp>
+
+/*!
+  \brief This macro defines the size of a GTIN-14.
+*/
+#define GTIN14_SIZE 14
+/*!
+  \brief This macro defines the size of a Serial Shipping Container Code (SSCC).
+*/
+#define SSCC_SIZE 18
+/*!
+  \brief This macro defines the size of a Global Location Number (GLN).
+*/
+#define GLN_SIZE 13
+/*!
+  \brief This macro defines the size of a Global Shipment Identification Number (GSIN).
+*/
+#define GSIN_SIZE 17
+
+/*!
+  \brief This macro defines the character transmitted for the FNC1 separator (ASCII group separator).
+*/
+#define GS1_FNC1 '\x1d'
+
+namespace boost {
+    namespace checkdigit{
+
+typedef features
+<
+  ean,
+  GTIN14_SIZE
+> gtin14;
+
+typedef features
+<
+  ean,
+  SSCC_SIZE
+> sscc;
+
+typedef features
+<
+  ean,
+  GLN_SIZE
+> gln;
+
+typedef features
+<
+  ean,
+  GSIN_SIZE
+> gsin;
+
+/*!
+    \brief Validate a GTIN-14.
+
+    \tparam check_range is a valid range type.
+    \param x is the sequence of value to check.
+
+    \returns @c true if x contains exactly GTIN14_SIZE digits and the check digit is correct, @c false otherwise.
+*/
+template <typename check_range>
+bool check_gtin14(const check_range& x)
+{
+  return check_sequence<gtin14>(x);
+}
+
+inline bool check_gtin14(const std::string& x)
+{
+  return check_sequence<gtin14>(make_precheck<digit>(x));
+}
+
+/*!
+    \brief Calculate the check digit of a GTIN-14.
+
+    \tparam check_range is a valid range type.
+    \param x is the sequence of value without the check digit.
+
+    \returns The check digit in the range [0..9], or bad_sequence if x doesn't contain exactly GTIN14_SIZE-1 digits.
+*/
+template <typename check_range>
+size_t compute_gtin14(const check_range& x)
+{
+  return compute_checkdigit<gtin14>(x);
+}
+
+inline size_t compute_gtin14(const std::string& x)
+{
+  return compute_checkdigit<gtin14>(make_precheck<digit>(x));
+}
+
+/*!
+    \brief Validate a Serial Shipping Container Code.
+
+    \tparam check_range is a valid range type.
+    \param x is the sequence of value to check.
+
+    \returns @c true if x contains exactly SSCC_SIZE digits and the check digit is correct, @c false otherwise.
+*/
+template <typename check_range>
+bool check_sscc(const check_range& x)
+{
+  return check_sequence<sscc>(x);
+}
+
+inline bool check_sscc(const std::string& x)
+{
+  return check_sequence<sscc>(make_precheck<digit>(x));
+}
+
+/*!
+    \brief Calculate the check digit of a Serial Shipping Container Code.
+
+    \tparam check_range is a valid range type.
+    \param x is the sequence of value without the check digit.
+
+    \returns The check digit in the range [0..9], or bad_sequence if x doesn't contain exactly SSCC_SIZE-1 digits.
+*/
+template <typename check_range>
+size_t compute_sscc(const check_range& x)
+{
+  return compute_checkdigit<sscc>(x);
+}
+
+inline size_t compute_sscc(const std::string& x)
+{
+  return compute_checkdigit<sscc>(make_precheck<digit>(x));
+}
+
+/*!
+    \brief Validate a Global Location Number.
+
+    \tparam check_range is a valid range type.
+    \param x is the sequence of value to check.
+
+    \returns @c true if x contains exactly GLN_SIZE digits and the check digit is correct, @c false otherwise.
+*/
+template <typename check_range>
+bool check_gln(const check_range& x)
+{
+  return check_sequence<gln>(x);
+}
+
+inline bool check_gln(const std::string& x)
+{
+  return check_sequence<gln>(make_precheck<digit>(x));
+}
+
+/*!
+    \brief Calculate the check digit of a Global Location Number.
+
+    \tparam check_range is a valid range type.
+    \param x is the sequence of value without the check digit.
+
+    \returns The check digit in the range [0..9], or bad_sequence if x doesn't contain exactly GLN_SIZE-1 digits.
+*/
+template <typename check_range>
+size_t compute_gln(const check_range& x)
+{
+  return compute_checkdigit<gln>(x);
+}
+
+inline size_t compute_gln(const std::string& x)
+{
+  return compute_checkdigit<gln>(make_precheck<digit>(x));
+}
+
+/*!
+    \brief Validate a Global Shipment Identification Number.
+
+    \tparam check_range is a valid range type.
+    \param x is the sequence of value to check.
+
+    \returns @c true if x contains exactly GSIN_SIZE digits and the check digit is correct, @c false otherwise.
+*/
+template <typename check_range>
+bool check_gsin(const check_range& x)
+{
+  return check_sequence<gsin>(x);
+}
+
+inline bool check_gsin(const std::string& x)
+{
+  return check_sequence<gsin>(make_precheck<digit>(x));
+}
+
+/*!
+    \brief Calculate the check digit of a Global Shipment Identification Number.
+
+    \tparam check_range is a valid range type.
+    \param x is the sequence of value without the check digit.
+
+    \returns The check digit in the range [0..9], or bad_sequence if x doesn't contain exactly GSIN_SIZE-1 digits.
+*/
+template <typename check_range>
+size_t compute_gsin(const check_range& x)
+{
+  return compute_checkdigit<gsin>(x);
+}
+
+inline size_t compute_gsin(const std::string& x)
+{
+  return compute_checkdigit<gsin>(make_precheck<digit>(x));
+}
+
+/*!
+  \brief Description of a GS1 Application Identifier (AI).
+*/
+struct gs1_ai
+{
+  //! The leading digits identifying the AI. The AI 31nn is described by "31" and ai_size = 4.
+  const char *prefix;
+  //! The number of digits of the AI.
+  unsigned char ai_size;
+  //! The size of the data field if fixed, its maximum size otherwise.
+  unsigned char data_size;
+  //! @c true if the data field has a variable size and is terminated by FNC1 (unless it ends the element string).
+  bool variable;
+  //! The size of the GS1 key beginning the data field and ending with a check digit, 0 if there is none.
+  unsigned char key_size;
+};
+
+/*!
+  \brief An element of a GS1 element string: an AI followed by its data field.
+*/
+struct gs1_element
+{
+  const gs1_ai *ai;
+  const char *data;
+  size_t data_size;
+};
+
+namespace detail
+{
+
+// Ordered so that a more specific prefix comes before a shorter one.
+static const gs1_ai gs1_ai_table[] =
+{
+  { "00",   2, 18, false, SSCC_SIZE },
+  { "01",   2, 14, false, GTIN14_SIZE },
+  { "02",   2, 14, false, GTIN14_SIZE },
+  { "10",   2, 20, true,  0 },
+  { "11",   2,  6, false, 0 },
+  { "12",   2,  6, false, 0 },
+  { "13",   2,  6, false, 0 },
+  { "15",   2,  6, false, 0 },
+  { "16",   2,  6, false, 0 },
+  { "17",   2,  6, false, 0 },
+  { "20",   2,  2, false, 0 },
+  { "21",   2, 20, true,  0 },
+  { "22",   2, 20, true,  0 },
+  { "235",  3, 28, true,  0 },
+  { "240",  3, 30, true,  0 },
+  { "241",  3, 30, true,  0 },
+  { "242",  3,  6, true,  0 },
+  { "243",  3, 20, true,  0 },
+  { "250",  3, 30, true,  0 },
+  { "251",  3, 30, true,  0 },
+  { "253",  3, 30, true,  GLN_SIZE },
+  { "254",  3, 20, true,  0 },
+  { "255",  3, 25, true,  GLN_SIZE },
+  { "30",   2,  8, true,  0 },
+  { "31",   4,  6, false, 0 },
+  { "32",   4,  6, false, 0 },
+  { "33",   4,  6, false, 0 },
+  { "34",   4,  6, false, 0 },
+  { "35",   4,  6, false, 0 },
+  { "36",   4,  6, false, 0 },
+  { "37",   2,  8, true,  0 },
+  { "39",   4, 18, true,  0 },
+  { "400",  3, 30, true,  0 },
+  { "401",  3, 30, true,  0 },
+  { "402",  3, 17, true,  GSIN_SIZE },
+  { "403",  3, 30, true,  0 },
+  { "41",   3, 13, false, GLN_SIZE },
+  { "420",  3, 20, true,  0 },
+  { "421",  3, 12, true,  0 },
+  { "422",  3,  3, true,  0 },
+  { "8003", 4, 30, true,  GTIN14_SIZE },
+  { "8004", 4, 30, true,  0 },
+  { "8006", 4, 18, true,  GTIN14_SIZE },
+  { "8017", 4, 18, true,  SSCC_SIZE },
+  { "8018", 4, 18, true,  SSCC_SIZE },
+  { "8020", 4, 25, true,  0 },
+  { "90",   2, 30, true,  0 },
+  { "91",   2, 90, true,  0 },
+  { "92",   2, 90, true,  0 },
+  { "93",   2, 90, true,  0 },
+  { "94",   2, 90, true,  0 },
+  { "95",   2, 90, true,  0 },
+  { "96",   2, 90, true,  0 },
+  { "97",   2, 90, true,  0 },
+  { "98",   2, 90, true,  0 },
+  { "99",   2, 90, true,  0 }
+};
+
+} // namespace detail
+
+/*!
+    \brief Find the Application Identifier beginning a sequence.
+
+    \param first is the beginning of the sequence.
+    \param last is the end of the sequence.
+
+    \returns The AI description, or 0 if the sequence doesn't begin with a known AI.
+*/
+inline const gs1_ai* find_gs1_ai(const char *first, const char *last)
+{
+  const size_t table_size = sizeof(detail::gs1_ai_table) / sizeof(detail::gs1_ai_table[0]);
+  for(size_t i = 0; i < table_size; ++i)
+  {
+    const gs1_ai &ai = detail::gs1_ai_table[i];
+    size_t prefix_size = std::strlen(ai.prefix);
+    if(static_cast<size_t>(last - first) >= ai.ai_size && std::memcmp(first, ai.prefix, prefix_size) == 0)
+    {
+      for(size_t j = prefix_size; j < ai.ai_size; ++j)
+        if(first[j] < '0' || first[j] > '9')
+          return 0;
+      return &ai;
+    }
+  }
+  return 0;
+}
+
+/*!
+    \brief Parse a GS1 element string (as carried by GS1-128 and GS1 DataMatrix) and validate the check digit of every GS1 key in the same pass.
+
+    \pre The FNC1 separators are transmitted as GS1_FNC1. A leading symbology identifier ("]C1", "]d2", "]Q3", ...) and a leading FNC1 are skipped.
+
+    \tparam OutputIterator must accept gs1_element values.
+    \param first is the beginning of the element string.
+    \param last is the end of the element string.
+    \param out receives the elements parsed.
+
+    \returns The position where parsing stopped: last if the element string is well-formed and every key is valid, the beginning of the faulty element otherwise.
+*/
+template <typename OutputIterator>
+const char* parse_gs1_element_string(const char *first, const char *last, OutputIterator out)
+{
+  if(last - first >= 3 && *first == ']')
+    first += 3;
+  if(first != last && *first == GS1_FNC1)
+    ++first;
+
+  while(first != last)
+  {
+    const gs1_ai *ai = find_gs1_ai(first, last);
+    if(ai == 0)
+      return first;
+
+    const char *data = first + ai->ai_size;
+    const char *data_end;
+    if(ai->variable)
+    {
+      data_end = data;
+      while(data_end != last && *data_end != GS1_FNC1 && data_end - data < ai->data_size)
+        ++data_end;
+      if(data_end == data || (data_end != last && *data_end != GS1_FNC1))
+        return first;
+    }
+    else
+    {
+      if(last - data < ai->data_size)
+        return first;
+      data_end = data + ai->data_size;
+    }
+
+    if(ai->key_size != 0)
+    {
+      if(static_cast<size_t>(data_end - data) < ai->key_size
+      || !detail::check_weight13(data, ai->key_size))
+        return first;
+    }
+
+    gs1_element element = { ai, data, static_cast<size_t>(data_end - data) };
+    *out++ = element;
+
+    first = data_end;
+    if(first != last && *first == GS1_FNC1)
+      ++first;
+  }
+  return first;
+}
+
+namespace detail
+{
+struct gs1_element_sink
+{
+  gs1_element_sink& operator*() { return *this; }
+  gs1_element_sink& operator++(int) { return *this; }
+  gs1_element_sink& operator=(const gs1_element&) { return *this; }
+};
+} // namespace detail
+
+/*!
+    \brief Validate a GS1 element string: its syntax and the check digit of every GS1 key it contains.
+
+    \param first is the beginning of the element string.
+    \param last is the end of the element string.
+
+    \returns @c true if the element string is well-formed and every key is valid, @c false otherwise.
+*/
+inline bool check_gs1_element_string(const char *first, const char *last)
+{
+  return parse_gs1_element_string(first, last, detail::gs1_element_sink()) == last;
+}
+
+inline bool check_gs1_element_string(const std::string& x)
+{
+  return check_gs1_element_string(x.data(), x.data() + x.size());
+}
+
+}} // namespace boost   namespace checkdigit
+#endif // BOOST_CHECKDIGIT_GS1_HPP
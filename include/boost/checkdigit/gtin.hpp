@@ -0,0 +1,159 @@
+//  Boost checks/gtin.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief This file provides tools to normalize UPC-E, UPC-A, EAN-8 and EAN-13 numbers into GTIN-14.
+
+    \details The weight<1,3> sum is anchored on the right, so padding a number with zeros on the left
+    doesn't change its checksum: the check digit of the source is carried to the GTIN-14 without
+    being computed again. The output is written into a buffer provided by the caller.
+*/
+
+#ifndef BOOST_CHECKDIGIT_GTIN_HPP
+#define BOOST_CHECKDIGIT_GTIN_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+#include <cstring>
+
+#include <boost/checkdigit/ean.hpp>
+#include <boost/checkdigit/upc.hpp>
+#include <boost/checkdigit/gs1.hpp>
+#include <boost/checkdigit/detail/digit_kernel.hpp>
+
+/*!
+  \brief This macro defines the size of an UPC-E (number system, 6 digits and the check digit).
+*/
+#define UPCE_SIZE 8
+
+namespace boost {
+    namespace checkdigit{
+
+/*!
+    \brief Expand an UPC-E into the UPC-A it stands for.
+
+    \param upce is the UPC-E: the number system (0 or 1), 6 digits and the check digit.
+    \param upca receives the UPC_SIZE digits of the UPC-A. The check digit is carried.
+
+    \returns @c true if the UPC-E is well-formed and its check digit is correct, @c false otherwise.
+*/
+inline bool upce_to_upca(const char *upce, char *upca)
+{
+  if(upce[0] != '0' && upce[0] != '1')
+    return false;
+
+  const char *d = upce + 1;
+  upca[0] = upce[0];
+  std::memset(upca + 1, '0', UPCA_SIZE - 2);
+  switch(d[5])
+  {
+    case '0': case '1': case '2':
+      // Manufacturer d1 d2 d6 0 0, product 0 0 d3 d4 d5.
+      upca[1] = d[0]; upca[2] = d[1]; upca[3] = d[5];
+      upca[8] = d[2]; upca[9] = d[3]; upca[10] = d[4];
+      break;
+    case '3':
+      upca[1] = d[0]; upca[2] = d[1]; upca[3] = d[2];
+      upca[9] = d[3]; upca[10] = d[4];
+      break;
+    case '4':
+      upca[1] = d[0]; upca[2] = d[1]; upca[3] = d[2]; upca[4] = d[3];
+      upca[10] = d[4];
+      break;
+    default:
+      upca[1] = d[0]; upca[2] = d[1]; upca[3] = d[2]; upca[4] = d[3]; upca[5] = d[4];
+      upca[10] = d[5];
+      break;
+  }
+  upca[UPCA_SIZE - 1] = upce[UPCE_SIZE - 1];
+  return detail::check_weight13(upca, UPCA_SIZE);
+}
+
+/*!
+    \brief Normalize an EAN-8, UPC-A, EAN-13 or GTIN-14 into a GTIN-14.
+
+    \param seq is the sequence of ASCII digits, check digit included.
+    \param size is the size of the sequence: EAN8_SIZE, UPCA_SIZE, EAN13_SIZE or GTIN14_SIZE.
+    \param gtin receives the GTIN14_SIZE digits of the GTIN-14. The check digit is carried.
+
+    \returns @c true if the size is supported and the check digit is correct, @c false otherwise.
+*/
+inline bool normalize_gtin14(const char *seq, size_t size, char *gtin)
+{
+  if(size != EAN8_SIZE && size != UPCA_SIZE && size != EAN13_SIZE && size != GTIN14_SIZE)
+    return false;
+  std::memset(gtin, '0', GTIN14_SIZE - size);
+  std::memcpy(gtin + GTIN14_SIZE - size, seq, size);
+  return detail::check_weight13(seq, size);
+}
+
+/*!
+    \brief Normalize an UPC-E into a GTIN-14.
+
+    \param upce is the UPC-E: the number system (0 or 1), 6 digits and the check digit.
+    \param gtin receives the GTIN14_SIZE digits of the GTIN-14. The check digit is carried.
+
+    \returns @c true if the UPC-E is well-formed and its check digit is correct, @c false otherwise.
+*/
+inline bool upce_to_gtin14(const char *upce, char *gtin)
+{
+  gtin[0] = '0';
+  gtin[1] = '0';
+  return upce_to_upca(upce, gtin + GTIN14_SIZE - UPCA_SIZE);
+}
+
+/*!
+    \brief Normalize a batch of EAN-8, UPC-A, EAN-13 or GTIN-14 into GTIN-14 without any allocation.
+
+    \param seqs are the sequences of ASCII digits, check digit included.
+    \param sizes are the sizes of the sequences.
+    \param count is the number of sequences.
+    \param gtins receives count * GTIN14_SIZE digits, one GTIN-14 after the other.
+    \param valid receives for each sequence the result of normalize_gtin14. The content of gtins is unspecified for an invalid sequence.
+
+    \returns The number of valid sequences.
+
+    \see normalize_gtin14
+*/
+inline size_t normalize_gtin14(const char * const *seqs, const size_t *sizes, size_t count, char *gtins, bool *valid)
+{
+  size_t valid_count = 0;
+  for(size_t i = 0; i < count; ++i, gtins += GTIN14_SIZE)
+  {
+    valid[i] = normalize_gtin14(seqs[i], sizes[i], gtins);
+    valid_count += valid[i];
+  }
+  return valid_count;
+}
+
+/*!
+    \brief Normalize a batch of UPC-E into GTIN-14 without any allocation.
+
+    \param upces are count UPC-E stored one after the other, every stride characters.
+    \param stride is the distance between two UPC-E (UPCE_SIZE if they are contiguous).
+    \param count is the number of UPC-E.
+    \param gtins receives count * GTIN14_SIZE digits, one GTIN-14 after the other.
+    \param valid receives for each UPC-E the result of upce_to_gtin14.
+
+    \returns The number of valid UPC-E.
+*/
+inline size_t upce_to_gtin14(const char *upces, size_t stride, size_t count, char *gtins, bool *valid)
+{
+  size_t valid_count = 0;
+  for(size_t i = 0; i < count; ++i, upces += stride, gtins += GTIN14_SIZE)
+  {
+    valid[i] = upce_to_gtin14(upces, gtins);
+    valid_count += valid[i];
+  }
+  return valid_count;
+}
+
+}} // namespace boost   namespace checkdigit
+#endif // BOOST_CHECKDIGIT_GTIN_HPP
@@ -0,0 +1,161 @@
+//  Boost checks/id_allocator.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief Allocate unique valid identifiers to several threads without lock.
+
+    \details The threads share an atomic cursor on the range of payloads. A thread reserves a block of consecutive
+    payloads with a single fetch_add, then fills its own buffer with the identifiers of the block using id_generator,
+    so the shared cursor is touched once per block and the check digits are computed incrementally.
+*/
+
+#ifndef BOOST_CHECKDIGIT_ID_ALLOCATOR_HPP
+#define BOOST_CHECKDIGIT_ID_ALLOCATOR_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+#include <atomic>
+#include <stdexcept>
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+
+#include <boost/checkdigit/id_generator.hpp>
+
+/*!
+  \brief This macro defines the maximal number of characters of an identifier of id_allocator (19 payload digits and the check digit).
+*/
+#define BOOST_CHECKDIGIT_ID_MAX_SIZE 20
+
+/*!
+  \brief This macro defines the default number of identifiers of a block of id_allocator.
+*/
+#define BOOST_CHECKDIGIT_ID_BLOCK_SIZE 64
+
+namespace boost {
+    namespace checkdigit{
+
+/*! \class id_allocator
+    \brief Share the payloads [first, last] between threads, as blocks of BlockSize consecutive payloads.
+
+    \tparam Features is the features type of the identifiers, as for id_generator.
+    \tparam BlockSize is the number of payloads reserved at once by a thread.
+*/
+template <typename Features, size_t BlockSize = BOOST_CHECKDIGIT_ID_BLOCK_SIZE>
+class id_allocator
+{
+  BOOST_STATIC_ASSERT(BlockSize > 0);
+
+  std::atomic<boost::uint64_t> cursor;
+  boost::uint64_t last;
+  size_t width;
+
+  id_allocator(const id_allocator&);
+  id_allocator& operator=(const id_allocator&);
+
+public:
+  /*! \class block
+      \brief The identifiers of a block, stored inline. A block is owned by a single thread.
+  */
+  class block
+  {
+    char ids[BlockSize * BOOST_CHECKDIGIT_ID_MAX_SIZE];
+    size_t count;
+    size_t next;
+    size_t size;
+
+    friend class id_allocator;
+
+  public:
+    block() : count(0), next(0), size(0)
+    {}
+
+    /*!
+      \brief Take the next identifier of the block.
+
+      \returns A pointer to the size() characters of the identifier, 0 if the block is empty.
+      The characters stay valid until the block is refilled.
+    */
+    const char *pop()
+    {
+      return next < count ? ids + size * next++ : 0;
+    }
+
+    //! The number of characters of an identifier.
+    size_t id_size() const
+    {
+      return size;
+    }
+
+    //! The number of identifiers not taken yet.
+    size_t remaining() const
+    {
+      return count - next;
+    }
+  };
+
+  /*!
+    \brief Allocate the payloads of the range [first, last].
+
+    \param first is the first payload.
+    \param last is the last payload.
+    \param width is the number of digits of a payload, the payloads being padded with zeros (at most BOOST_CHECKDIGIT_ID_MAX_SIZE - 1).
+
+    \throws std::invalid_argument if an identifier does not fit into BOOST_CHECKDIGIT_ID_MAX_SIZE characters, or if
+    last >= 10^width (the cursor could wrap around after every thread overshot the range by a block).
+  */
+  id_allocator(boost::uint64_t first, boost::uint64_t last, size_t width)
+  : cursor(first), last(last), width(width)
+  {
+    if(width + 1 > BOOST_CHECKDIGIT_ID_MAX_SIZE)
+      throw std::invalid_argument("The identifiers are larger than BOOST_CHECKDIGIT_ID_MAX_SIZE.");
+    boost::uint64_t bound = 1;
+    for(size_t k = 0; k < width; ++k)
+      bound *= 10;
+    if(last >= bound)
+      throw std::invalid_argument("The last payload has more digits than the width.");
+  }
+
+  /*!
+    \brief Reserve the next block of payloads and fill the block with their identifiers.
+
+    \returns The number of identifiers of the block, 0 if the range is exhausted.
+  */
+  size_t allocate(block &b)
+  {
+    boost::uint64_t start = cursor.fetch_add(BlockSize, std::memory_order_relaxed);
+    if(start > last)
+    {
+      b.count = b.next = 0;
+      return 0;
+    }
+    size_t count = last - start < BlockSize ? static_cast<size_t>(last - start) + 1 : BlockSize;
+    id_generator<Features> generator(start, width);
+    b.size = generator.size();
+    b.count = generator.generate(b.ids, count);
+    b.next = 0;
+    return b.count;
+  }
+
+  /*!
+    \brief Take an identifier, refilling the block from the shared range if it is empty.
+
+    \returns A pointer to the characters of the identifier, valid until the block is refilled, 0 if the range is exhausted.
+  */
+  const char *allocate_id(block &b)
+  {
+    const char *id = b.pop();
+    if(id == 0 && allocate(b) != 0)
+      id = b.pop();
+    return id;
+  }
+};
+
+}} // namespace boost   namespace checkdigit
+#endif // BOOST_CHECKDIGIT_ID_ALLOCATOR_HPP
@@ -0,0 +1,214 @@
+//  Boost checks/id_generator.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief Generate the consecutive valid sequences of a numeric range.
+
+    \details The generator keeps the partial checksum of every suffix of the traversal (the check digit position
+    followed by the payload digits from the lowest to the highest). An increment only changes the digits up to the
+    last carry, so only the partial checksums of these low-order positions are recomputed, which is constant time
+    on average. The identifiers of a decade (the same payload except its last digit) share the checksum of their high-order
+    digits, so a block of ten identifiers is written by copying the current identifier and setting two characters.
+*/
+
+#ifndef BOOST_CHECKDIGIT_ID_GENERATOR_HPP
+#define BOOST_CHECKDIGIT_ID_GENERATOR_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+#include <cstring>
+#include <string>
+#include <stdexcept>
+#include <vector>
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+
+#include <boost/checkdigit/traversal.hpp>
+#include <boost/checkdigit/partial_checksum.hpp>
+
+/*!
+  \brief This macro defines the number of identifiers sharing their high-order digits, written together by id_generator::generate.
+*/
+#define BOOST_CHECKDIGIT_GENERATOR_BLOCK 10
+
+namespace boost {
+    namespace checkdigit{
+
+/*! \class id_generator
+    \brief Generate the valid sequences of consecutive payloads, check digit included.
+
+    \tparam Features is the features type, with a reverse traversal and a single check digit at the position 0.
+    partial_checksum must be specialized for its processor.
+*/
+template <typename Features>
+class id_generator
+{
+  BOOST_STATIC_ASSERT((boost::is_base_of<reverse_traversal, Features>::value));
+  BOOST_STATIC_ASSERT(Features::checksum::checkdigit_detail::pos == 0 && Features::checksum::checkdigit_detail::size == 1);
+
+  typedef partial_checksum<typename Features::checksum::processor> partial;
+  typedef typename partial::state state;
+
+  // The position 0 is the check digit, taken as 0 (a null value at the position 0 adds nothing to any checksum);
+  // the positions 1..width are the payload digits from the lowest. suffixes[k] is the state of the positions [k, width].
+  std::vector<size_t> values;
+  std::vector<state> suffixes;
+  std::string current;
+  bool exhausted;
+
+  void update(size_t from)
+  {
+    for(size_t k = from + 1; k-- > 0;)
+    {
+      state single = partial::empty();
+      partial::push(single, values[k]);
+      suffixes[k] = partial::combine(single, suffixes[k + 1]);
+    }
+    current[current.size() - 1] = checkdigit_character(suffixes[0]);
+  }
+
+  static char checkdigit_character(const state &s)
+  {
+    size_t checkdigit = typename Features::checksum::make_checkdigit()(partial::checksum(s));
+    return checkdigit == 10 ? 'X' : static_cast<char>('0' + checkdigit);
+  }
+
+  void increment()
+  {
+    size_t width = values.size() - 1;
+    size_t k = 1;
+    for(; k <= width && values[k] == 9; ++k)
+    {
+      values[k] = 0;
+      current[width - k] = '0';
+    }
+    if(k > width)
+    {
+      exhausted = true;
+      return;
+    }
+    ++values[k];
+    ++current[width - k];
+    update(k);
+  }
+
+public:
+  /*!
+    \brief Start the generation at a payload.
+
+    \param payload is the first payload, its digits without check digit. Its size is the size of all the payloads.
+
+    \throws std::invalid_argument if a character of the payload is not a digit.
+  */
+  explicit id_generator(const std::string &payload)
+  : values(payload.size() + 1), suffixes(payload.size() + 2), current(payload + '0'), exhausted(payload.empty())
+  {
+    for(size_t k = 1; k <= payload.size(); ++k)
+    {
+      values[k] = static_cast<size_t>(static_cast<unsigned char>(payload[payload.size() - k])) - '0';
+      if(values[k] > 9)
+        throw std::invalid_argument("The payload contains a character that is not a digit.");
+    }
+    suffixes[payload.size() + 1] = partial::empty();
+    update(payload.size());
+  }
+
+  /*!
+    \brief Start the generation at a number.
+
+    \param first is the first payload.
+    \param width is the number of digits of the payloads, the number being padded with zeros.
+  */
+  id_generator(boost::uint64_t first, size_t width)
+  : values(width + 1), suffixes(width + 2), current(width + 1, '0'), exhausted(width == 0)
+  {
+    for(size_t k = 1; k <= width; ++k, first /= 10)
+    {
+      values[k] = static_cast<size_t>(first % 10);
+      current[width - k] = static_cast<char>('0' + values[k]);
+    }
+    suffixes[width + 1] = partial::empty();
+    update(width);
+  }
+
+  //! The number of characters of an identifier, check digit included.
+  size_t size() const
+  {
+    return current.size();
+  }
+
+  //! @c true if the last payload of the width has been generated.
+  bool done() const
+  {
+    return exhausted;
+  }
+
+  /*!
+    \brief Write the current identifier and go to the next payload.
+
+    \param out receives size() characters.
+
+    \returns @c false if every payload has already been generated (nothing is written), @c true otherwise.
+  */
+  bool next(char *out)
+  {
+    if(exhausted)
+      return false;
+    std::memcpy(out, current.data(), current.size());
+    increment();
+    return true;
+  }
+
+  /*!
+    \brief Write the next identifiers, one after the other.
+
+    \param out receives count * size() characters.
+    \param count is the number of identifiers to write.
+
+    \returns The number of identifiers written, lower than count if the payloads are exhausted.
+  */
+  size_t generate(char *out, size_t count)
+  {
+    size_t n = current.size();
+    size_t written = 0;
+    while(written < count && !exhausted)
+    {
+      // A whole decade: the check digits only depend on the last payload digit and the shared high-order state.
+      if(values.size() > 1 && values[1] == 0 && count - written >= BOOST_CHECKDIGIT_GENERATOR_BLOCK)
+      {
+        state zero = partial::empty();
+        partial::push(zero, 0);
+        for(size_t d = 0; d < BOOST_CHECKDIGIT_GENERATOR_BLOCK; ++d, out += n)
+        {
+          state low = zero;
+          partial::push(low, d);
+          std::memcpy(out, current.data(), n);
+          out[n - 2] = static_cast<char>('0' + d);
+          out[n - 1] = checkdigit_character(partial::combine(low, suffixes[2]));
+        }
+        written += BOOST_CHECKDIGIT_GENERATOR_BLOCK;
+        values[1] = 9;
+        current[n - 2] = '9';
+        increment();
+      }
+      else
+      {
+        next(out);
+        out += n;
+        ++written;
+      }
+    }
+    return written;
+  }
+};
+
+}} // namespace boost   namespace checkdigit
+#endif // BOOST_CHECKDIGIT_ID_GENERATOR_HPP
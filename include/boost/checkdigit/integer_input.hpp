@@ -0,0 +1,215 @@
+//  Boost checks/integer_input.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief Validate or compute the check digit of sequences stored as unsigned integers.
+
+    \details The digits are extracted two at a time from the least significant ones, which are the first ones of a reverse
+    traversal: the division by the constant 100 is compiled into a multiplication by its reciprocal and the two digits of the
+    remainder are read from a table. For a features type with a size, the integer is padded with implicit leading zeros.
+*/
+
+#ifndef BOOST_CHECKDIGIT_INTEGER_INPUT_HPP
+#define BOOST_CHECKDIGIT_INTEGER_INPUT_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+#include <boost/cstdint.hpp>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <boost/checkdigit/basic_checks.hpp>
+#include <boost/checkdigit/traversal.hpp>
+#include <boost/checkdigit/detail/digit_kernel.hpp>
+
+/*!
+  \brief This macro defines the maximal number of decimal digits of a 64 bits unsigned integer.
+*/
+#define BOOST_CHECKDIGIT_UINT64_DIGITS 20
+
+/*!
+  \brief This macro defines the number of integers processed together by the batch validation.
+*/
+#define BOOST_CHECKDIGIT_INTEGER_BATCH 64
+
+namespace boost {
+    namespace checkdigit{
+
+namespace detail
+{
+
+struct digit_pairs
+{
+  unsigned char values[100][2]; // The low digit, then the high digit.
+
+  digit_pairs()
+  {
+    for(size_t i = 0; i < 100; ++i)
+    {
+      values[i][0] = static_cast<unsigned char>(i % 10);
+      values[i][1] = static_cast<unsigned char>(i / 10);
+    }
+  }
+};
+
+/*!
+  \brief The number of decimal digits of x, 1 for 0.
+*/
+inline size_t integer_digits(boost::uint64_t x)
+{
+  size_t digits = 1;
+  for(; x >= 10; x /= 10)
+    ++digits;
+  return digits;
+}
+
+/*!
+  \brief Process the digits digits of x from the least significant one, at the positions pos, pos + 1...
+
+  \post x is divided by 10^digits: it is not null if x had more digits.
+*/
+template <typename Processor>
+size_t integer_checksum(boost::uint64_t &x, size_t digits, size_t pos)
+{
+  static const digit_pairs pairs;
+  Processor process;
+  size_t checksum = 0;
+  size_t k = 0;
+  for(; k + 2 <= digits; k += 2, pos += 2)
+  {
+    boost::uint64_t quotient = x / 100;
+    size_t remainder = static_cast<size_t>(x - quotient * 100);
+    x = quotient;
+    checksum = process(checksum, pairs.values[remainder][0], pos);
+    checksum = process(checksum, pairs.values[remainder][1], pos + 1);
+  }
+  if(k < digits)
+  {
+    checksum = process(checksum, static_cast<size_t>(x % 10), pos);
+    x /= 10;
+  }
+  return checksum;
+}
+
+template <typename Features>
+struct integer_features
+{
+  BOOST_STATIC_ASSERT((boost::is_base_of<reverse_traversal, Features>::value));
+  BOOST_STATIC_ASSERT(Features::checksum::checkdigit_detail::pos == 0);
+
+  typedef typename Features::checksum::processor processor;
+  static const size_t checkdigit_size = Features::checksum::checkdigit_detail::size;
+};
+
+} // namespace detail
+
+/*!
+    \brief Validate a sequence given as an integer.
+
+    \tparam Features is the features type of the sequence, with a reverse traversal.
+    \param x is the sequence, check digit included. If the features type has a size, x is padded with leading zeros.
+
+    \returns @c true if x has at most Features::size digits and if its check digit is correct, @c false otherwise.
+*/
+template <typename Features>
+bool check_integer(boost::uint64_t x)
+{
+  typedef detail::integer_features<Features> traits;
+  size_t digits = Features::size ? Features::size : detail::integer_digits(x);
+  size_t checksum = detail::integer_checksum<typename traits::processor>(x, digits, 0);
+  return x == 0 && typename Features::checksum::validate_checkdigit()(checksum);
+}
+
+/*!
+    \brief Calculate the check digit of a payload given as an integer.
+
+    \tparam Features is the features type of the sequence, with a reverse traversal.
+    \param payload is the sequence without its check digit. If the features type has a size, the payload is padded with leading zeros.
+
+    \returns The check digit, or bad_sequence if the payload has too many digits.
+*/
+template <typename Features>
+size_t compute_integer(boost::uint64_t payload)
+{
+  typedef detail::integer_features<Features> traits;
+  size_t digits = Features::size ? Features::size - traits::checkdigit_size : detail::integer_digits(payload);
+  size_t checksum = detail::integer_checksum<typename traits::processor>(payload, digits, traits::checkdigit_size);
+  if(payload != 0)
+    return bad_sequence;
+  return typename Features::checksum::make_checkdigit()(checksum);
+}
+
+namespace detail
+{
+
+// Additive processor: the digit positions in the outer loop, the integers of the batch in the inner loop.
+// Without a size, the integers are padded to BOOST_CHECKDIGIT_UINT64_DIGITS digits: a null digit contributes nothing.
+template <typename Features>
+void check_integer_batch(const boost::uint64_t *values, size_t count, bool *valid, boost::true_type)
+{
+  const size_t digits = Features::size ? Features::size : BOOST_CHECKDIGIT_UINT64_DIGITS;
+
+  typedef checksum_contribution<typename Features::checksum::processor> contribution;
+
+  // Each position divides the remainders by 10, so the integer digits are not read through additive_checksums.
+  boost::uint64_t remainders[BOOST_CHECKDIGIT_INTEGER_BATCH];
+  size_t checksums[BOOST_CHECKDIGIT_INTEGER_BATCH] = { 0 };
+  for(size_t r = 0; r < count; ++r)
+    remainders[r] = values[r];
+  for(size_t pos = 0; pos < digits; ++pos)
+  {
+    for(size_t r = 0; r < count; ++r)
+    {
+      boost::uint64_t quotient = remainders[r] / 10;
+      checksums[r] += contribution::at(static_cast<size_t>(remainders[r] - quotient * 10), pos);
+      remainders[r] = quotient;
+    }
+  }
+  for(size_t r = 0; r < count; ++r)
+    valid[r] = remainders[r] == 0 && typename Features::checksum::validate_checkdigit()(checksums[r]);
+}
+
+template <typename Features>
+void check_integer_batch(const boost::uint64_t *values, size_t count, bool *valid, boost::false_type)
+{
+  for(size_t r = 0; r < count; ++r)
+    valid[r] = check_integer<Features>(values[r]);
+}
+
+} // namespace detail
+
+/*!
+    \brief Validate a column of sequences given as integers.
+
+    \tparam Features is the features type of the sequences, with a reverse traversal.
+    \param values are the sequences, check digit included.
+    \param count is the number of sequences.
+    \param valid receives the result of each sequence.
+
+    \returns The number of valid sequences.
+*/
+template <typename Features>
+size_t check_integer(const boost::uint64_t *values, size_t count, bool *valid)
+{
+  typedef boost::integral_constant<bool, checksum_contribution<typename Features::checksum::processor>::additive> additive;
+  for(size_t first = 0; first < count; first += BOOST_CHECKDIGIT_INTEGER_BATCH)
+  {
+    size_t n = count - first < BOOST_CHECKDIGIT_INTEGER_BATCH ? count - first : BOOST_CHECKDIGIT_INTEGER_BATCH;
+    detail::check_integer_batch<Features>(values + first, n, valid + first, additive());
+  }
+  size_t valid_count = 0;
+  for(size_t r = 0; r < count; ++r)
+    valid_count += valid[r];
+  return valid_count;
+}
+
+}} // namespace boost   namespace checkdigit
+#endif // BOOST_CHECKDIGIT_INTEGER_INPUT_HPP
@@ -0,0 +1,179 @@
+//  Boost checks/isbn_conversion.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief This file provides tools to convert an ISBN-10 into an ISBN-13 and conversely.
+
+    \details The source is validated and converted in a single pass: the checksum of the source
+    and the partial checksum of the target are accumulated together, the contribution of the
+    prefix 978 being a constant. The converted form is written into a buffer provided by the caller.
+*/
+
+#ifndef BOOST_CHECKDIGIT_ISBN_CONVERSION_HPP
+#define BOOST_CHECKDIGIT_ISBN_CONVERSION_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+
+#include <boost/checkdigit/isbn.hpp>
+#include <boost/checkdigit/filter.hpp>
+
+namespace boost {
+    namespace checkdigit{
+
+namespace detail
+{
+// Weighted sum of the prefix 978 in an ISBN-13: 9*1 + 7*3 + 8*1.
+static const size_t isbn13_prefix_sum = 38;
+} // namespace detail
+
+/*!
+    \brief Validate an ISBN-10 and convert it into an ISBN-13.
+
+    \tparam Iterator must meet the InputIterator requirements, the values are characters.
+    \param first is the beginning of the ISBN-10. The characters others than digits and 'X' are skipped (hyphens, spaces).
+    \param last is the end of the ISBN-10.
+    \param isbn13 receives the EAN13_SIZE digits of the ISBN-13.
+
+    \returns @c true if the ISBN-10 is valid, @c false otherwise (the content of isbn13 is then unspecified).
+*/
+template <typename Iterator>
+bool isbn10_to_isbn13(Iterator first, Iterator last, char *isbn13)
+{
+  digitx_filter filter;
+  size_t isbn10_sum = 0;
+  size_t isbn13_sum = detail::isbn13_prefix_sum;
+  size_t i = 0;
+
+  isbn13[0] = '9'; isbn13[1] = '7'; isbn13[2] = '8';
+  for(; first != last; ++first)
+  {
+    char c = *first;
+    if(!filter(c))
+      continue;
+    if(i < ISBN10_SIZE - 1)
+    {
+      if(!digit_filter()(c))
+        return false;
+      size_t value = c - '0';
+      // Weights 10..2 for the ISBN-10, alternatively 3 and 1 after the prefix for the ISBN-13.
+      isbn10_sum += value * (ISBN10_SIZE - i);
+      isbn13_sum += value * (i & 1 ? 1 : 3);
+      isbn13[3 + i] = c;
+    }
+    else if(i == ISBN10_SIZE - 1)
+      isbn10_sum += digit_filter()(c) ? size_t(c - '0') : 10;
+    else
+      return false;
+    ++i;
+  }
+  if(i != ISBN10_SIZE || isbn10_sum % 11 != 0)
+    return false;
+
+  isbn13[EAN13_SIZE - 1] = static_cast<char>('0' + (10 - isbn13_sum % 10) % 10);
+  return true;
+}
+
+/*!
+    \brief Validate an ISBN-13 of the prefix 978 and convert it into an ISBN-10.
+
+    \tparam Iterator must meet the InputIterator requirements, the values are characters.
+    \param first is the beginning of the ISBN-13. The characters others than digits are skipped (hyphens, spaces).
+    \param last is the end of the ISBN-13.
+    \param isbn10 receives the ISBN10_SIZE characters of the ISBN-10, the check digit may be 'X'.
+
+    \returns @c true if the ISBN-13 is valid and begins with 978, @c false otherwise (the content of isbn10 is then unspecified).
+
+    \remarks The ISBN-13 of the prefix 979 have no ISBN-10 equivalent.
+*/
+template <typename Iterator>
+bool isbn13_to_isbn10(Iterator first, Iterator last, char *isbn10)
+{
+  static const char prefix[] = "978";
+  digit_filter filter;
+  size_t isbn13_sum = 0;
+  size_t isbn10_sum = 0;
+  size_t i = 0;
+
+  for(; first != last; ++first)
+  {
+    char c = *first;
+    if(!filter(c))
+      continue;
+    if(i == EAN13_SIZE)
+      return false;
+    size_t value = c - '0';
+    isbn13_sum += value * (i & 1 ? 3 : 1);
+    if(i < 3)
+    {
+      if(c != prefix[i])
+        return false;
+    }
+    else if(i < EAN13_SIZE - 1)
+    {
+      isbn10_sum += value * (ISBN10_SIZE + 3 - i);
+      isbn10[i - 3] = c;
+    }
+    ++i;
+  }
+  if(i != EAN13_SIZE || isbn13_sum % 10 != 0)
+    return false;
+
+  size_t checkdigit = (11 - isbn10_sum % 11) % 11;
+  isbn10[ISBN10_SIZE - 1] = checkdigit == 10 ? 'X' : static_cast<char>('0' + checkdigit);
+  return true;
+}
+
+/*!
+    \brief Validate and convert a batch of ISBN-10 into ISBN-13 without any allocation.
+
+    \param seqs are the ISBN-10.
+    \param sizes are the sizes of the ISBN-10 (separators included).
+    \param count is the number of ISBN-10.
+    \param isbn13s receives count * EAN13_SIZE digits, one ISBN-13 after the other.
+    \param valid receives for each ISBN-10 the result of isbn10_to_isbn13.
+
+    \returns The number of valid ISBN-10.
+*/
+inline size_t isbn10_to_isbn13(const char * const *seqs, const size_t *sizes, size_t count, char *isbn13s, bool *valid)
+{
+  size_t valid_count = 0;
+  for(size_t i = 0; i < count; ++i, isbn13s += EAN13_SIZE)
+  {
+    valid[i] = isbn10_to_isbn13(seqs[i], seqs[i] + sizes[i], isbn13s);
+    valid_count += valid[i];
+  }
+  return valid_count;
+}
+
+/*!
+    \brief Validate and convert a batch of ISBN-13 into ISBN-10 without any allocation.
+
+    \param seqs are the ISBN-13.
+    \param sizes are the sizes of the ISBN-13 (separators included).
+    \param count is the number of ISBN-13.
+    \param isbn10s receives count * ISBN10_SIZE characters, one ISBN-10 after the other.
+    \param valid receives for each ISBN-13 the result of isbn13_to_isbn10.
+
+    \returns The number of valid ISBN-13.
+*/
+inline size_t isbn13_to_isbn10(const char * const *seqs, const size_t *sizes, size_t count, char *isbn10s, bool *valid)
+{
+  size_t valid_count = 0;
+  for(size_t i = 0; i < count; ++i, isbn10s += ISBN10_SIZE)
+  {
+    valid[i] = isbn13_to_isbn10(seqs[i], seqs[i] + sizes[i], isbn10s);
+    valid_count += valid[i];
+  }
+  return valid_count;
+}
+
+}} // namespace boost   namespace checkdigit
+#endif // BOOST_CHECKDIGIT_ISBN_CONVERSION_HPP
@@ -0,0 +1,281 @@
+//  Boost checks/iso6346.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief This file provides tools to compute and validate an ISO 6346 shipping container code.
+
+    \details A container code is made of an owner code of 3 letters, an equipment category identifier
+    (a letter), a serial number of 6 digits and a check digit. The letters are valued from 10 skipping the
+    multiples of 11 (A = 10, B = 12, ..., Z = 38), the weight of the value at the index i (from the left)
+    is 2^i and the check digit is the weighted sum modulus 11 modulus 10.
+*/
+
+#ifndef BOOST_CHECKDIGIT_ISO6346_HPP
+#define BOOST_CHECKDIGIT_ISO6346_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+#include <string>
+
+#include <boost/preprocessor/repetition.hpp>
+#include <boost/checkdigit/checksum.hpp>
+#include <boost/checkdigit/basic_checks.hpp>
+#include <boost/checkdigit/precheck.hpp>
+
+/*!
+  \brief This macro defines the size of an ISO 6346 container code.
+*/
+#define ISO6346_SIZE 11
+
+/*!
+  \brief This macro defines the number of letters beginning an ISO 6346 container code.
+*/
+#define ISO6346_LETTERS 4
+
+namespace boost {
+    namespace checkdigit{
+
+namespace detail
+{
+
+// Value of the letter of rank n (A = 0): from 10, skipping 11, 22 and 33.
+constexpr unsigned char iso6346_letter_value(unsigned int n)
+{
+  return n < 1 ? 10 : n < 11 ? 11 + n : n < 21 ? 12 + n : 13 + n;
+}
+
+#define BOOST_CHECKDIGIT_ISO6346_LETTER_VALUE(z, n, unused) iso6346_letter_value(n)
+
+// Indexed by (letter - 'A') & 31 so that an invalid character can't read outside the table.
+static constexpr unsigned char iso6346_letter_values[32] =
+{
+  BOOST_PP_ENUM(26, BOOST_CHECKDIGIT_ISO6346_LETTER_VALUE, ~), 0, 0, 0, 0, 0, 0
+};
+
+#undef BOOST_CHECKDIGIT_ISO6346_LETTER_VALUE
+
+// The check digit is stored as a multiple of this factor, above any weighted sum (38 * 1023)
+// and without changing the weighted sum modulus 11.
+static const size_t iso6346_checkdigit_factor = 11 << 12;
+
+} // namespace detail
+
+/*!
+  \brief Filter the characters of a container code: the digits and the upper-case letters.
+*/
+struct iso6346_filter
+{
+  typedef bool result_type;
+
+  template <typename value_type>
+  bool operator()(value_type value) const
+  {
+    return (value >= '0' && value <= '9') || (value >= 'A' && value <= 'Z');
+  }
+};
+
+/*!
+  \brief Transliterate a character of a container code into its value.
+*/
+struct iso6346_transliteration
+{
+  typedef size_t result_type;
+
+  template <typename value_type>
+  size_t operator()(const value_type &value) const
+  {
+    return value <= '9' ? size_t(value - '0') : detail::iso6346_letter_values[(value - 'A') & 31];
+  }
+};
+
+typedef precheck<iso6346_filter, iso6346_transliteration> iso6346_precheck;
+
+/*!
+  \brief Compute the ISO 6346 weighted sum: the value at the position pos (from the right, the check digit being at 0) is shifted by ISO6346_SIZE - 1 - pos.
+
+  \remarks The check digit is not added to the weighted sum but stored as a multiple of a factor of 11 above it, see iso6346_validation.
+*/
+struct iso6346_processor
+{
+  size_t operator()(size_t checksum, size_t value, size_t pos)
+  {
+    if(pos == 0)
+      return checksum + value * detail::iso6346_checkdigit_factor;
+    return checksum + (value << (ISO6346_SIZE - 1 - pos));
+  }
+};
+
+/*!
+  \brief Validate the ISO 6346 checksum: the check digit stored must be equal to the weighted sum modulus 11 modulus 10.
+*/
+struct iso6346_validation
+{
+  bool operator()(size_t checksum)
+  {
+    return checksum / detail::iso6346_checkdigit_factor == checksum % 11 % 10;
+  }
+};
+
+/*!
+  \brief Compute the ISO 6346 check digit from the weighted sum.
+*/
+struct iso6346_checkdigit
+{
+  size_t operator()(size_t checksum)
+  {
+    return checksum % 11 % 10;
+  }
+};
+
+typedef features
+<
+  checksum
+  <
+    iso6346_processor,
+    iso6346_validation,
+    iso6346_checkdigit
+  >,
+  ISO6346_SIZE
+> iso6346;
+
+/*!
+    \brief Validate an ISO 6346 container code.
+
+    \tparam check_range is a valid range type, its values already transliterated.
+    \param x is the sequence of value to check.
+
+    \returns @c true if x contains exactly ISO6346_SIZE values and the check digit is correct, @c false otherwise.
+*/
+template <typename check_range>
+bool check_iso6346(const check_range& x)
+{
+  return check_sequence<iso6346>(x);
+}
+
+/*!
+    \brief Calculate the check digit of an ISO 6346 container code.
+
+    \tparam check_range is a valid range type, its values already transliterated.
+    \param x is the sequence of value without the check digit.
+
+    \returns The check digit in the range [0..9], or bad_sequence if x doesn't contain exactly ISO6346_SIZE-1 values.
+*/
+template <typename check_range>
+size_t compute_iso6346(const check_range& x)
+{
+  return compute_checkdigit<iso6346>(x);
+}
+
+namespace detail
+{
+
+#define BOOST_CHECKDIGIT_ISO6346_LETTER(z, n, unused) \
+  value = static_cast<unsigned char>(code[n]) - 'A'; \
+  invalid |= value > 25; \
+  sum += static_cast<size_t>(iso6346_letter_values[value & 31]) << n;
+
+#define BOOST_CHECKDIGIT_ISO6346_DIGIT(z, n, unused) \
+  value = static_cast<unsigned char>(code[n]) - '0'; \
+  invalid |= value > 9; \
+  sum += static_cast<size_t>(value) << n;
+
+/*!
+  \brief Compute the weighted sum of the ISO6346_SIZE - 1 first characters of a container code, fully unrolled.
+
+  \returns The weighted sum, or bad_sequence if the code is not made of 4 upper-case letters followed by digits.
+*/
+inline size_t iso6346_sum(const char *code)
+{
+  unsigned int value;
+  unsigned int invalid = 0;
+  size_t sum = 0;
+  BOOST_PP_REPEAT(ISO6346_LETTERS, BOOST_CHECKDIGIT_ISO6346_LETTER, ~)
+  BOOST_PP_REPEAT_FROM_TO(ISO6346_LETTERS, BOOST_PP_DEC(ISO6346_SIZE), BOOST_CHECKDIGIT_ISO6346_DIGIT, ~)
+  return invalid ? bad_sequence : sum;
+}
+
+#undef BOOST_CHECKDIGIT_ISO6346_LETTER
+#undef BOOST_CHECKDIGIT_ISO6346_DIGIT
+
+// Copy the characters of x kept by iso6346_filter into code, returns false unless there are exactly size of them.
+inline bool iso6346_characters(const std::string& x, char *code, size_t size)
+{
+  iso6346_filter filter;
+  size_t n = 0;
+  for(std::string::const_iterator it = x.begin(); it != x.end(); ++it)
+  {
+    if(!filter(*it))
+      continue;
+    if(n == size)
+      return false;
+    code[n++] = *it;
+  }
+  return n == size;
+}
+
+} // namespace detail
+
+/*!
+    \brief Validate a batch of ISO 6346 container codes stored in fixed size records, such as a TOS event stream.
+
+    \param codes is the first container code, without separator.
+    \param stride is the distance between two container codes (ISO6346_SIZE if they are contiguous).
+    \param count is the number of container codes.
+    \param valid receives for each container code @c true if it is valid, @c false otherwise.
+
+    \returns The number of valid container codes.
+*/
+inline size_t check_iso6346(const char *codes, size_t stride, size_t count, bool *valid)
+{
+  size_t valid_count = 0;
+  for(size_t i = 0; i < count; ++i, codes += stride)
+  {
+    size_t sum = detail::iso6346_sum(codes);
+    unsigned int checkdigit = static_cast<unsigned char>(codes[ISO6346_SIZE - 1]) - '0';
+    valid[i] = sum != bad_sequence && sum % 11 % 10 == checkdigit;
+    valid_count += valid[i];
+  }
+  return valid_count;
+}
+
+/*!
+    \brief Validate an ISO 6346 container code, the separators (spaces, dashes...) being skipped.
+
+    \param x is the container code.
+
+    \returns @c true if x is made of 4 upper-case letters, 6 digits and the correct check digit, @c false otherwise.
+*/
+inline bool check_iso6346(const std::string& x)
+{
+  char code[ISO6346_SIZE];
+  bool valid = false;
+  if(detail::iso6346_characters(x, code, ISO6346_SIZE))
+    check_iso6346(code, ISO6346_SIZE, 1, &valid);
+  return valid;
+}
+
+/*!
+    \brief Calculate the check digit of an ISO 6346 container code, the separators (spaces, dashes...) being skipped.
+
+    \param x is the container code without the check digit.
+
+    \returns The check digit in the range [0..9], or bad_sequence if x is not made of 4 upper-case letters and 6 digits.
+*/
+inline size_t compute_iso6346(const std::string& x)
+{
+  char code[ISO6346_SIZE - 1];
+  if(!detail::iso6346_characters(x, code, ISO6346_SIZE - 1))
+    return bad_sequence;
+  size_t sum = detail::iso6346_sum(code);
+  return sum == bad_sequence ? bad_sequence : sum % 11 % 10;
+}
+
+}} // namespace boost   namespace checkdigit
+#endif // BOOST_CHECKDIGIT_ISO6346_HPP
@@ -0,0 +1,250 @@
+//  Boost checks/kernel_planner.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief Choose the fastest validation of fixed size columns on the running machine, and remember it.
+
+    \details The candidate kernels of a features type compute the same results: "scalar" validates a row after the
+    other with check_sequence, "column" is the batch path of check_fixed_column, which processes the rows by batches
+    with the positions in the outer loop. The winner depends on the machine, the scheme and the width. At the first use
+    of a (scheme, width) pair, the planner times every candidate on a synthetic column and keeps the fastest. The plans
+    are saved into a text file, a line per plan, keyed by the CPU model, so the next processes on the same machine load
+    the plan instead of timing the candidates again.
+*/
+
+#ifndef BOOST_CHECKDIGIT_KERNEL_PLANNER_HPP
+#define BOOST_CHECKDIGIT_KERNEL_PLANNER_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+#include <string>
+#include <vector>
+#include <map>
+#include <fstream>
+#include <sstream>
+#include <chrono>
+#include <boost/cstdint.hpp>
+
+#include <boost/checkdigit/columnar.hpp>
+
+/*!
+  \brief This macro defines the number of rows of the synthetic column timed by the planner.
+*/
+#define BOOST_CHECKDIGIT_PLANNER_ROWS 4096
+
+/*!
+  \brief This macro defines the number of timings of a candidate, the fastest one being kept.
+*/
+#define BOOST_CHECKDIGIT_PLANNER_RUNS 5
+
+namespace boost {
+    namespace checkdigit{
+
+/*!
+  \brief A kernel and its name in the plans.
+*/
+struct kernel_candidate
+{
+  const char *name;
+  column_kernel kernel;
+};
+
+namespace detail
+{
+
+// The rows of a fixed size column one after the other, without the batch path.
+template <typename Features, typename Precheck>
+size_t scalar_kernel(const char *data, size_t width, size_t length, const boost::uint8_t *validity, bitmap_word *bitmap)
+{
+  fixed_column<Features, Precheck>::check(data, width, length, validity, bitmap, static_cast<boost::uint32_t*>(0), boost::false_type());
+  return bitmap_count(bitmap, length);
+}
+
+inline std::string trim(const std::string &x)
+{
+  std::string::size_type first = x.find_first_not_of(" \t");
+  std::string::size_type last = x.find_last_not_of(" \t\r\n");
+  return first == std::string::npos ? std::string() : x.substr(first, last - first + 1);
+}
+
+} // namespace detail
+
+/*!
+  \brief The candidate kernels of a features type.
+
+  \returns The number of candidates written into candidates (at most 2).
+*/
+template <typename Features, typename Precheck>
+size_t column_candidates(kernel_candidate *candidates)
+{
+  kernel_candidate scalar = { "scalar", &detail::scalar_kernel<Features, Precheck> };
+  kernel_candidate column = { "column", &check_fixed_column<Features, Precheck> };
+  candidates[0] = scalar;
+  candidates[1] = column;
+  return 2;
+}
+
+/*!
+  \brief The model name of the CPU, "unknown" if it cannot be read.
+*/
+inline std::string cpu_model()
+{
+  std::ifstream cpuinfo("/proc/cpuinfo");
+  std::string line;
+  while(std::getline(cpuinfo, line))
+  {
+    if(line.compare(0, 10, "model name") == 0 && line.find(':') != std::string::npos)
+      return detail::trim(line.substr(line.find(':') + 1));
+  }
+  return "unknown";
+}
+
+/*! \class kernel_planner
+    \brief Time the candidate kernels of a scheme at its first use and keep the plans in a file.
+
+    The plan file has a line per plan: the CPU model, the scheme name, the width and the candidate name, separated by
+    tabulations. The plans of the other CPU models are kept when the file is saved.
+*/
+class kernel_planner
+{
+  typedef std::map<std::string, std::string> plan_map;
+
+  std::string path;
+  std::string cpu;
+  plan_map plans;            // "scheme\twidth" -> candidate name, for this CPU.
+  std::vector<std::string> other_lines;
+
+  static std::string key(const std::string &scheme, size_t width)
+  {
+    std::ostringstream os;
+    os << scheme << '\t' << width;
+    return os.str();
+  }
+
+  static double time(column_kernel kernel, const std::vector<char> &column, size_t width, std::vector<bitmap_word> &bitmap)
+  {
+    double best = 0;
+    for(size_t run = 0; run < BOOST_CHECKDIGIT_PLANNER_RUNS; ++run)
+    {
+      std::chrono::steady_clock::time_point start = std::chrono::steady_clock::now();
+      kernel(&column[0], width, BOOST_CHECKDIGIT_PLANNER_ROWS, 0, &bitmap[0]);
+      double elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+      if(run == 0 || elapsed < best)
+        best = elapsed;
+    }
+    return best;
+  }
+
+public:
+  /*!
+    \brief Load the plans of the running CPU.
+
+    \param path is the plan file, it may not exist yet.
+  */
+  explicit kernel_planner(const std::string &path)
+  : path(path), cpu(cpu_model())
+  {
+    std::ifstream file(path.c_str());
+    std::string line;
+    while(std::getline(file, line))
+    {
+      std::string::size_type tab = line.find('\t');
+      std::string::size_type last = line.rfind('\t');
+      if(tab == std::string::npos || last == tab)
+        continue;
+      if(line.compare(0, tab, cpu) == 0)
+        plans[line.substr(tab + 1, last - tab - 1)] = line.substr(last + 1);
+      else
+        other_lines.push_back(line);
+    }
+  }
+
+  /*!
+    \brief The name of the candidate planned for a scheme and a width.
+
+    \returns The name of the candidate, an empty string if the pair has not been planned yet.
+  */
+  std::string planned(const std::string &scheme, size_t width) const
+  {
+    plan_map::const_iterator it = plans.find(key(scheme, width));
+    return it == plans.end() ? std::string() : it->second;
+  }
+
+  /*!
+    \brief Time the candidates of a features type and plan the fastest one, even if the pair is already planned.
+
+    \tparam Features is the features type of the scheme.
+    \tparam Precheck is the precheck of the scheme.
+    \param scheme is the name of the scheme in the plans.
+    \param width is the width of the columns.
+
+    \returns The fastest kernel.
+  */
+  template <typename Features, typename Precheck>
+  column_kernel measure(const std::string &scheme, size_t width)
+  {
+    kernel_candidate candidates[2];
+    size_t count = column_candidates<Features, Precheck>(candidates);
+
+    std::vector<char> column(BOOST_CHECKDIGIT_PLANNER_ROWS * width + 1);
+    for(size_t i = 0; i + 1 < column.size(); ++i)
+      column[i] = static_cast<char>('0' + (i * 7 + i / width) % 10);
+    std::vector<bitmap_word> bitmap(bitmap_size(BOOST_CHECKDIGIT_PLANNER_ROWS));
+
+    size_t best = 0;
+    double best_time = 0;
+    for(size_t c = 0; c < count; ++c)
+    {
+      double elapsed = time(candidates[c].kernel, column, width, bitmap);
+      if(c == 0 || elapsed < best_time)
+      {
+        best = c;
+        best_time = elapsed;
+      }
+    }
+    plans[key(scheme, width)] = candidates[best].name;
+    return candidates[best].kernel;
+  }
+
+  /*!
+    \brief The kernel of a scheme and a width, timing the candidates at the first use of the pair.
+
+    \returns The planned kernel.
+  */
+  template <typename Features, typename Precheck>
+  column_kernel plan(const std::string &scheme, size_t width)
+  {
+    std::string name = planned(scheme, width);
+    kernel_candidate candidates[2];
+    size_t count = column_candidates<Features, Precheck>(candidates);
+    for(size_t c = 0; c < count; ++c)
+      if(name == candidates[c].name)
+        return candidates[c].kernel;
+    return measure<Features, Precheck>(scheme, width);
+  }
+
+  /*!
+    \brief Write the plans into the plan file.
+
+    \returns @c true if the file has been written, @c false otherwise.
+  */
+  bool save() const
+  {
+    std::ofstream file(path.c_str());
+    for(size_t i = 0; i < other_lines.size(); ++i)
+      file << other_lines[i] << '\n';
+    for(plan_map::const_iterator it = plans.begin(); it != plans.end(); ++it)
+      file << cpu << '\t' << it->first << '\t' << it->second << '\n';
+    return static_cast<bool>(file);
+  }
+};
+
+}} // namespace boost   namespace checkdigit
+#endif // BOOST_CHECKDIGIT_KERNEL_PLANNER_HPP
@@ -24,6 +24,8 @@
 #include <boost/range/iterator_range.hpp>
 
 #include <boost/checkdigit/checksum.hpp> 
+#include <boost/checkdigit/basic_checks.hpp>
+#include <boost/checkdigit/precheck.hpp>
 
 namespace boost {
     namespace checkdigit{
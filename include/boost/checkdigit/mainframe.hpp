@@ -0,0 +1,274 @@
+//  Boost checks/mainframe.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief Validate the numeric fields of mainframe records: EBCDIC zoned decimal and packed decimal (COMP-3).
+
+    \details A zoned field has a digit per byte, from 0xF0 to 0xF9. A packed field has two digits per byte, the last
+    nibble being the sign (0xA to 0xF). The digits are read in place from the least significant one, which is the
+    first one of a reverse traversal, and fed to the processor without converting the field to ASCII. The fields are
+    numbers: for a features type with a size, a shorter field is padded with implicit leading zeros and the extra
+    leading digits of a longer field must be zeros; without a size, the leading zeros are ignored.
+*/
+
+#ifndef BOOST_CHECKDIGIT_MAINFRAME_HPP
+#define BOOST_CHECKDIGIT_MAINFRAME_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <boost/checkdigit/precheck.hpp>
+#include <boost/checkdigit/traversal.hpp>
+#include <boost/checkdigit/detail/digit_kernel.hpp>
+
+/*!
+  \brief This macro defines the number of records validated together by check_zoned and check_packed.
+*/
+#define BOOST_CHECKDIGIT_MAINFRAME_BATCH 64
+
+namespace boost {
+    namespace checkdigit{
+
+struct ebcdic_digit_filter
+{
+  typedef bool result_type;
+
+  template <typename value_type>
+  bool operator()(value_type value) const
+  {
+    unsigned char c = static_cast<unsigned char>(value);
+    return c >= 0xF0 && c <= 0xF9;
+  }
+};
+
+struct ebcdic_to_digit
+{
+  typedef size_t result_type;
+
+  template <typename value_type>
+  size_t operator()(const value_type &value) const
+  {
+    return static_cast<unsigned char>(value) & 0x0F;
+  }
+};
+
+/*!
+  \brief The precheck of the sequences of EBCDIC digits, to use with make_precheck.
+*/
+typedef precheck<ebcdic_digit_filter, ebcdic_to_digit> ebcdic_digit;
+
+namespace detail
+{
+
+// The digit at the position k from the end of a field, a value greater than 9 if the byte is not a digit.
+struct zoned_field
+{
+  static size_t digits(size_t field_size)
+  {
+    return field_size;
+  }
+
+  static bool sign(const unsigned char *, size_t)
+  {
+    return true;
+  }
+
+  static size_t at(const unsigned char *field, size_t field_size, size_t k)
+  {
+    return static_cast<size_t>(field[field_size - 1 - k]) - 0xF0;
+  }
+};
+
+// The last byte holds the lowest digit and the sign, the byte before it the two next digits...
+struct packed_field
+{
+  static size_t digits(size_t field_size)
+  {
+    return field_size ? 2 * field_size - 1 : 0;
+  }
+
+  static bool sign(const unsigned char *field, size_t field_size)
+  {
+    return field_size && (field[field_size - 1] & 0x0F) >= 0x0A;
+  }
+
+  static size_t at(const unsigned char *field, size_t field_size, size_t k)
+  {
+    unsigned char byte = field[field_size - 1 - (k + 1) / 2];
+    return k % 2 ? byte & 0x0F : byte >> 4;
+  }
+};
+
+// The digits of the fields of fixed-width records, as Field::at.
+template <typename Field>
+struct field_digits
+{
+  const unsigned char *records;
+  size_t stride;
+  size_t field_size;
+
+  size_t operator()(size_t r, size_t k) const
+  {
+    return Field::at(records + r * stride, field_size, k);
+  }
+};
+
+template <typename Features, typename Field>
+struct numeric_field
+{
+  BOOST_STATIC_ASSERT((boost::is_base_of<reverse_traversal, Features>::value));
+  BOOST_STATIC_ASSERT(Features::checksum::checkdigit_detail::pos == 0);
+
+  // Additive processor: the positions in the outer loop, the records of the batch in the inner loop.
+  // The leading zeros of a field without size contribute nothing, so every digit of the field is processed.
+  static void batch(const unsigned char *records, size_t stride, size_t field_size, size_t count, bool *valid, boost::true_type)
+  {
+    const size_t digits = Field::digits(field_size);
+    const size_t processed = Features::size && Features::size < digits ? Features::size : digits;
+
+    size_t checksums[BOOST_CHECKDIGIT_MAINFRAME_BATCH] = { 0 };
+    unsigned char invalid[BOOST_CHECKDIGIT_MAINFRAME_BATCH] = { 0 };
+    field_digits<Field> field = { records, stride, field_size };
+    additive_checksums<typename Features::checksum::processor>(field, processed, 0, count, checksums, invalid);
+    for(size_t k = processed; k < digits; ++k)
+    {
+      for(size_t r = 0; r < count; ++r)
+        invalid[r] |= Field::at(records + r * stride, field_size, k) != 0;
+    }
+    for(size_t r = 0; r < count; ++r)
+      valid[r] = !invalid[r] && digits > 0 && Field::sign(records + r * stride, field_size) &&
+                 typename Features::checksum::validate_checkdigit()(checksums[r]);
+  }
+
+  // Other processors (Verhoeff): one record after the other.
+  static void batch(const unsigned char *records, size_t stride, size_t field_size, size_t count, bool *valid, boost::false_type)
+  {
+    const size_t digits = Field::digits(field_size);
+    for(size_t r = 0; r < count; ++r)
+    {
+      const unsigned char *field = records + r * stride;
+      bool ok = Field::sign(field, field_size);
+      size_t length = digits;
+      if(Features::size)
+      {
+        for(size_t k = Features::size; k < digits && ok; ++k)
+          ok = Field::at(field, field_size, k) == 0;
+        length = Features::size;
+      }
+      else
+      {
+        while(length > 1 && Field::at(field, field_size, length - 1) == 0)
+          --length;
+      }
+
+      typename Features::checksum::processor process;
+      size_t checksum = 0;
+      for(size_t k = 0; k < length && ok; ++k)
+      {
+        size_t value = k < digits ? Field::at(field, field_size, k) : 0;
+        // A value out of the tables of the processor is never processed.
+        ok = value <= 9;
+        if(ok)
+          checksum = process(checksum, value, k);
+      }
+      valid[r] = ok && digits > 0 && typename Features::checksum::validate_checkdigit()(checksum);
+    }
+  }
+
+  static size_t check(const unsigned char *records, size_t stride, size_t field_size, size_t count, bool *valid)
+  {
+    typedef boost::integral_constant<bool, checksum_contribution<typename Features::checksum::processor>::additive> additive;
+    for(size_t first = 0; first < count; first += BOOST_CHECKDIGIT_MAINFRAME_BATCH)
+    {
+      size_t n = count - first < BOOST_CHECKDIGIT_MAINFRAME_BATCH ? count - first : BOOST_CHECKDIGIT_MAINFRAME_BATCH;
+      batch(records + first * stride, stride, field_size, n, valid + first, additive());
+    }
+    size_t valid_count = 0;
+    for(size_t r = 0; r < count; ++r)
+      valid_count += valid[r];
+    return valid_count;
+  }
+};
+
+} // namespace detail
+
+/*!
+    \brief Validate the EBCDIC zoned decimal fields of fixed-width records.
+
+    \tparam Features is the features type of the field, with a reverse traversal and the check digit(s) at the end.
+    \param records points to the field of the first record.
+    \param stride is the number of bytes between the beginnings of two records.
+    \param field_size is the number of bytes of the field.
+    \param count is the number of records.
+    \param valid receives the result of each record.
+
+    \returns The number of valid fields.
+*/
+template <typename Features>
+size_t check_zoned(const unsigned char *records, size_t stride, size_t field_size, size_t count, bool *valid)
+{
+  return detail::numeric_field<Features, detail::zoned_field>::check(records, stride, field_size, count, valid);
+}
+
+/*!
+    \brief Validate an EBCDIC zoned decimal field.
+
+    \tparam Features is the features type of the field, with a reverse traversal and the check digit(s) at the end.
+    \param field is the field.
+    \param field_size is the number of bytes of the field.
+
+    \returns @c true if every byte of the field is an EBCDIC digit and if its check digit is correct, @c false otherwise.
+*/
+template <typename Features>
+bool check_zoned(const unsigned char *field, size_t field_size)
+{
+  bool valid;
+  return check_zoned<Features>(field, field_size, field_size, 1, &valid) == 1;
+}
+
+/*!
+    \brief Validate the packed decimal (COMP-3) fields of fixed-width records.
+
+    \tparam Features is the features type of the field, with a reverse traversal and the check digit(s) at the end.
+    \param records points to the field of the first record.
+    \param stride is the number of bytes between the beginnings of two records.
+    \param field_size is the number of bytes of the field. The field has 2 * field_size - 1 digits.
+    \param count is the number of records.
+    \param valid receives the result of each record.
+
+    \returns The number of valid fields.
+*/
+template <typename Features>
+size_t check_packed(const unsigned char *records, size_t stride, size_t field_size, size_t count, bool *valid)
+{
+  return detail::numeric_field<Features, detail::packed_field>::check(records, stride, field_size, count, valid);
+}
+
+/*!
+    \brief Validate a packed decimal (COMP-3) field.
+
+    \tparam Features is the features type of the field, with a reverse traversal and the check digit(s) at the end.
+    \param field is the field.
+    \param field_size is the number of bytes of the field.
+
+    \returns @c true if the nibbles of the field are digits followed by a sign and if its check digit is correct, @c false otherwise.
+*/
+template <typename Features>
+bool check_packed(const unsigned char *field, size_t field_size)
+{
+  bool valid;
+  return check_packed<Features>(field, field_size, field_size, 1, &valid) == 1;
+}
+
+}} // namespace boost   namespace checkdigit
+#endif // BOOST_CHECKDIGIT_MAINFRAME_HPP
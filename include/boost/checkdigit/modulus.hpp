@@ -34,6 +34,22 @@ struct modulus
   }
 };
 
+template <size_t mod>
+struct modulus_validation
+{
+  BOOST_STATIC_ASSERT_MSG(mod != 0, "Cannot divide by 0.");
+
+  typedef bool result_type;
+  typedef size_t argument_type;
+
+  static const size_t modulus_value = mod;
+
+  result_type operator()(argument_type value)
+  {
+    return value % mod == 0;
+  }
+};
+
 template <size_t mod>
 struct modulus_inv
 {
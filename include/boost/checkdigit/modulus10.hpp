@@ -26,6 +26,9 @@ typedef checkdigit_encoder<> mod10_basic_encoder;
 typedef checkdigit<mod10_basic, mod10_basic_encoder> mod10_basic_checkdigit;
 typedef checkdigit<mod10_inv_basic, mod10_basic_encoder> mod10_inv_basic_checkdigit;
 
+typedef modulus_validation<10> mod10_validation;
+typedef mod10_inv_basic mod10_checkdigit;
+
 }}  // namespace boost   namespace checkdigit
 
 #endif //BOOST_CHECKDIGIT_MOD10_HPP
@@ -15,6 +15,9 @@
 #include <boost/checkdigit/weight.hpp>
 #include <boost/checkdigit/modulus.hpp>
 #include <boost/checkdigit/checkdigit.hpp>
+#include <boost/checkdigit/weighted_sum.hpp>
+#include <boost/checkdigit/checksum.hpp>
+#include <boost/checkdigit/basic_checks.hpp>
 
 namespace boost{
   namespace checkdigit{
@@ -26,8 +29,78 @@ typedef checkdigitx_encoder mod11_basic_encoder;
 typedef checkdigit<mod11_basic, mod11_basic_encoder> mod11_basic_checkdigit;
 typedef checkdigit<mod11_inv_basic, mod11_basic_encoder> mod11_inv_basic_checkdigit;
 
+typedef modulus_validation<11> mod11_validation;
+typedef mod11_inv_basic mod11_checkdigit;
+
 typedef weight<1,2,3,4,5,6,7,8,9,10> mod11_weight;
 
+typedef weighted_sum<mod11_weight> mod11_processor;
+
+typedef checksum
+<
+  mod11_processor,
+  mod11_validation,
+  mod11_checkdigit
+> mod11;
+
+/*!
+    \brief Validate a sequence according to the modulus 11 algorithm.
+
+    \tparam size_expected is the number of valid values expected in the sequence.
+    \tparam check_range is a valid range type.
+    \param check_seq is the sequence of value to check.
+
+    \returns @c true if the check digit is correct, @c false otherwise.
+*/
+template <size_t size_expected, typename check_range>
+bool check_modulus11(const check_range& check_seq)
+{
+  return check_sequence<features<mod11, size_expected> >(check_seq);
+}
+
+/*!
+    \brief Validate a sequence according to the modulus 11 algorithm.
+
+    \tparam check_range is a valid range type.
+    \param check_seq is the sequence of value to check.
+
+    \returns @c true if the check digit is correct, @c false otherwise.
+*/
+template <typename check_range>
+bool check_modulus11(const check_range& check_seq)
+{
+  return check_sequence<features<mod11> >(check_seq);
+}
+
+/*!
+    \brief Calculate the check digit of a sequence according to the modulus 11 algorithm.
+
+    \tparam size_expected is the number of valid values expected in the sequence, check digit included.
+    \tparam check_range is a valid range type.
+    \param check_seq is the sequence of value to check.
+
+    \returns The check digit in the range [0..10], or bad_sequence if the size is not the expected one.
+*/
+template <size_t size_expected, typename check_range>
+size_t compute_modulus11(const check_range& check_seq)
+{
+  return compute_checkdigit<features<mod11, size_expected> >(check_seq);
+}
+
+/*!
+    \brief Calculate the check digit of a sequence according to the modulus 11 algorithm.
+
+    \tparam check_range is a valid range type.
+    \param check_seq is the sequence of value to check.
+
+    \returns The check digit in the range [0..10].
+*/
+template <typename check_range>
+size_t compute_modulus11(const check_range& check_seq)
+{
+  return compute_checkdigit<features<mod11> >(check_seq);
+}
+
 }} // namespace boost  namespace checkdigit
 
 
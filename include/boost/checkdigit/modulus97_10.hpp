@@ -13,8 +13,12 @@
     #pragma once
 #endif
 
+#include <string>
 #include <boost/checkdigit/weight.hpp>
 #include <boost/checkdigit/checkdigit.hpp>
+#include <boost/checkdigit/checksum.hpp>
+#include <boost/checkdigit/basic_checks.hpp>
+#include <boost/checkdigit/precheck.hpp>
 
 namespace boost{
   namespace checkdigit{
@@ -53,6 +57,114 @@ struct mod97_10_processor
   }
 };
 
+/*!
+  \brief A sequence is valid if its checksum modulo 97 is 1.
+*/
+struct mod97_10_validation
+{
+  bool operator()(size_t checksum)
+  {
+    return checksum % 97 == 1;
+  }
+};
+
+/*!
+  \brief The two check digits are the last two digits of the sequence.
+*/
+struct mod97_10_checkdigits
+{
+  static const size_t pos = 0;
+  static const size_t size = 2;
+};
+
+typedef checksum
+<
+  mod97_10_processor,
+  mod97_10_validation,
+  mod97_10,
+  mod97_10_checkdigits
+> modulus97_10;
+
+/*!
+    \brief Validate a sequence according to the modulus 97-10 algorithm (ISO/IEC 7064:2003).
+
+    \tparam size_expected is the number of valid values expected in the sequence, check digits included.
+    \tparam check_range is a valid range type.
+    \param check_seq is the sequence of value to check.
+
+    \returns @c true if the check digits are correct, @c false otherwise.
+*/
+template <size_t size_expected, typename check_range>
+bool check_mod97_10(const check_range& check_seq)
+{
+  return check_sequence<features<modulus97_10, size_expected> >(check_seq);
+}
+
+template <size_t size_expected>
+bool check_mod97_10(const std::string& x)
+{
+  return check_sequence<features<modulus97_10, size_expected> >(make_precheck<digit>(x));
+}
+
+/*!
+    \brief Validate a sequence of any size according to the modulus 97-10 algorithm (ISO/IEC 7064:2003).
+
+    \tparam check_range is a valid range type.
+    \param check_seq is the sequence of value to check.
+
+    \returns @c true if the check digits are correct, @c false otherwise.
+*/
+template <typename check_range>
+bool check_mod97_10(const check_range& check_seq)
+{
+  return check_sequence<features<modulus97_10> >(check_seq);
+}
+
+inline bool check_mod97_10(const std::string& x)
+{
+  return check_sequence<features<modulus97_10> >(make_precheck<digit>(x));
+}
+
+/*!
+    \brief Calculate the check digits of a sequence according to the modulus 97-10 algorithm (ISO/IEC 7064:2003).
+
+    \tparam size_expected is the number of valid values expected in the sequence, check digits included.
+    \tparam check_range is a valid range type.
+    \param check_seq is the sequence without its check digits.
+
+    \returns The check digits in the range [2..98], or bad_sequence if the size is not the expected one.
+*/
+template <size_t size_expected, typename check_range>
+size_t compute_mod97_10(const check_range& check_seq)
+{
+  return compute_checkdigit<features<modulus97_10, size_expected> >(check_seq);
+}
+
+template <size_t size_expected>
+size_t compute_mod97_10(const std::string& x)
+{
+  return compute_checkdigit<features<modulus97_10, size_expected> >(make_precheck<digit>(x));
+}
+
+/*!
+    \brief Calculate the check digits of a sequence of any size according to the modulus 97-10 algorithm (ISO/IEC 7064:2003).
+
+    \tparam check_range is a valid range type.
+    \param check_seq is the sequence without its check digits.
+
+    \returns The check digits in the range [2..98].
+*/
+template <typename check_range>
+size_t compute_mod97_10(const check_range& check_seq)
+{
+  return compute_checkdigit<features<modulus97_10> >(check_seq);
+}
+
+inline size_t compute_mod97_10(const std::string& x)
+{
+  return compute_checkdigit<features<modulus97_10> >(make_precheck<digit>(x));
+}
+
 }} // namespace boost   namespace checkdigit
 
 #endif //BOOST_CHECKDIGIT_MOD97_10_HPP
@@ -0,0 +1,304 @@
+//  Boost checks/ocr_repair.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief Find the valid readings of a sequence produced by an optical character recognition.
+
+    \details A confusion policy gives the possible digits of each character with a cost: 0 for a digit, 1 for a
+    letter commonly read instead of a digit (O and 0, I l and 1, S and 5, B and 8, Z and 2...). The readings are
+    searched depth first in the traversal order, the partial checksum being pushed at each level. A branch is cut as
+    soon as its cost plus the minimal cost of the remaining characters exceeds the maximal cost. The characters after
+    the last ambiguous one have a single reading, so their partial checksum is computed once: at the last ambiguous
+    character, the search combines each reading with it and only keeps the readings satisfying the validation of the
+    scheme, without going down the remaining characters.
+*/
+
+#ifndef BOOST_CHECKDIGIT_OCR_REPAIR_HPP
+#define BOOST_CHECKDIGIT_OCR_REPAIR_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <boost/type_traits/is_base_of.hpp>
+
+#include <boost/checkdigit/traversal.hpp>
+#include <boost/checkdigit/partial_checksum.hpp>
+
+/*!
+  \brief This macro defines the maximal number of readings of a character.
+*/
+#define BOOST_CHECKDIGIT_OCR_MAX_READINGS 3
+
+/*!
+  \brief This macro defines the default maximal cost of a reading of a sequence.
+*/
+#define BOOST_CHECKDIGIT_OCR_MAX_COST 3
+
+namespace boost {
+    namespace checkdigit{
+
+/*!
+  \brief A possible value of a character and the cost of this reading.
+*/
+struct ocr_reading
+{
+  size_t value;
+  size_t cost;
+};
+
+/*!
+  \brief A valid reading of a sequence.
+*/
+struct ocr_candidate
+{
+  //! The digits of the reading, 'X' for the value 10.
+  std::string sequence;
+  //! The sum of the costs of the readings of the characters.
+  size_t cost;
+
+  bool operator<(const ocr_candidate &other) const
+  {
+    return cost < other.cost || (cost == other.cost && sequence < other.sequence);
+  }
+};
+
+/*!
+  \brief Confusion policy for the digit sequences.
+
+  \returns The number of readings written into readings, 0 if the character is ignored (separators).
+*/
+struct ocr_digit
+{
+  size_t operator()(char c, ocr_reading *readings) const
+  {
+    if(c >= '0' && c <= '9')
+      return make(readings, c - '0', 0);
+    switch(c)
+    {
+      case 'O': case 'o': case 'Q': case 'D':
+        return make(readings, 0, 1);
+      case 'I': case 'l': case 'i': case '|': case '!':
+        return make(readings, 1, 1);
+      case 'Z': case 'z':
+        return make(readings, 2, 1, 7, 2);
+      case 'A':
+        return make(readings, 4, 2);
+      case 'S': case 's': case '$':
+        return make(readings, 5, 1);
+      case 'G': case 'b':
+        return make(readings, 6, 1);
+      case 'T':
+        return make(readings, 7, 1);
+      case 'B':
+        return make(readings, 8, 1, 3, 2);
+      case 'g': case 'q':
+        return make(readings, 9, 1);
+    }
+    return 0;
+  }
+
+protected:
+  static size_t make(ocr_reading *readings, size_t value, size_t cost)
+  {
+    readings[0].value = value;
+    readings[0].cost = cost;
+    return 1;
+  }
+
+  static size_t make(ocr_reading *readings, size_t value, size_t cost, size_t value2, size_t cost2)
+  {
+    make(readings, value, cost);
+    make(readings + 1, value2, cost2);
+    return 2;
+  }
+};
+
+/*!
+  \brief Confusion policy for the digit sequences whose check digit can be 'X' (value 10), as ISBN-10.
+*/
+struct ocr_digitx : ocr_digit
+{
+  size_t operator()(char c, ocr_reading *readings) const
+  {
+    if(c == 'X' || c == 'x')
+      return make(readings, 10, 0);
+    if(c == 'K' || c == 'k')
+      return make(readings, 10, 1);
+    return ocr_digit::operator()(c, readings);
+  }
+};
+
+namespace detail
+{
+
+template <typename Features>
+class ocr_search
+{
+  typedef partial_checksum<typename Features::checksum::processor> partial;
+  typedef typename partial::state state;
+
+  const std::vector<ocr_reading> &readings; // BOOST_CHECKDIGIT_OCR_MAX_READINGS readings per position, in the traversal order.
+  const std::vector<size_t> &counts;        // The number of readings per position.
+  std::vector<size_t> min_costs;            // min_costs[pos] is the minimal cost of the positions [pos, n).
+  std::vector<size_t> chosen;
+  size_t solved;                            // The last position with several readings (0 if there is none).
+  std::vector<state> suffixes;              // suffixes[pos] is the state of the single readings of the positions [pos, n), pos > solved.
+  bool fixed_suffix;                        // false if a single reading after solved is not allowed at its position.
+  size_t max_cost;
+  std::vector<std::vector<size_t> > &results;
+  std::vector<size_t> &costs;
+
+  // The value 10 is only a check digit.
+  static bool allowed(const ocr_reading &reading, size_t pos)
+  {
+    return reading.value <= 9 || pos == 0;
+  }
+
+  // The positions after solved have a single reading: their state is known, so the readings of solved are kept
+  // only if they complete it into a valid checksum, without going down the remaining positions.
+  void solve(const state &s, size_t cost)
+  {
+    for(size_t r = 0; r < counts[solved]; ++r)
+    {
+      const ocr_reading &reading = readings[solved * BOOST_CHECKDIGIT_OCR_MAX_READINGS + r];
+      if(cost + reading.cost + min_costs[solved + 1] > max_cost || !allowed(reading, solved))
+        continue;
+      state next = s;
+      partial::push(next, reading.value);
+      if(typename Features::checksum::validate_checkdigit()(partial::checksum(partial::combine(next, suffixes[solved + 1]))))
+      {
+        chosen[solved] = reading.value;
+        results.push_back(chosen);
+        costs.push_back(cost + reading.cost + min_costs[solved + 1]);
+      }
+    }
+  }
+
+  void search(size_t pos, const state &s, size_t cost)
+  {
+    if(pos == solved)
+    {
+      solve(s, cost);
+      return;
+    }
+    for(size_t r = 0; r < counts[pos]; ++r)
+    {
+      const ocr_reading &reading = readings[pos * BOOST_CHECKDIGIT_OCR_MAX_READINGS + r];
+      if(cost + reading.cost + min_costs[pos + 1] > max_cost || !allowed(reading, pos))
+        continue;
+      state next = s;
+      partial::push(next, reading.value);
+      chosen[pos] = reading.value;
+      search(pos + 1, next, cost + reading.cost);
+    }
+  }
+
+public:
+  ocr_search(const std::vector<ocr_reading> &readings, const std::vector<size_t> &counts, size_t max_cost,
+             std::vector<std::vector<size_t> > &results, std::vector<size_t> &costs)
+  : readings(readings), counts(counts), min_costs(counts.size() + 1), chosen(counts.size()), solved(0),
+    suffixes(counts.size() + 1), fixed_suffix(true), max_cost(max_cost), results(results), costs(costs)
+  {
+    for(size_t pos = counts.size(); pos-- > 0;)
+    {
+      size_t min_cost = readings[pos * BOOST_CHECKDIGIT_OCR_MAX_READINGS].cost;
+      for(size_t r = 1; r < counts[pos]; ++r)
+        min_cost = (std::min)(min_cost, readings[pos * BOOST_CHECKDIGIT_OCR_MAX_READINGS + r].cost);
+      min_costs[pos] = min_costs[pos + 1] + min_cost;
+      if(counts[pos] > 1 && solved == 0)
+        solved = pos;
+    }
+
+    suffixes[counts.size()] = partial::empty();
+    for(size_t pos = counts.size(); pos-- > solved + 1;)
+    {
+      const ocr_reading &reading = readings[pos * BOOST_CHECKDIGIT_OCR_MAX_READINGS];
+      fixed_suffix = fixed_suffix && allowed(reading, pos);
+      chosen[pos] = reading.value;
+      state single = partial::empty();
+      partial::push(single, reading.value);
+      suffixes[pos] = partial::combine(single, suffixes[pos + 1]);
+    }
+  }
+
+  void run()
+  {
+    if(fixed_suffix && min_costs[0] <= max_cost)
+      search(0, partial::empty(), 0);
+  }
+};
+
+} // namespace detail
+
+/*!
+    \brief Find the valid readings of a sequence, ranked by cost.
+
+    \tparam Features is the features type of the sequence, partial_checksum must be specialized for its processor.
+    \tparam Confusion is the confusion policy (ocr_digit or ocr_digitx).
+    \tparam OutputIterator must accept ocr_candidate values.
+    \param x is the sequence read.
+    \param out receives the valid readings, by increasing cost.
+    \param max_cost is the maximal cost of a reading.
+
+    \returns The output iterator after the last reading written.
+*/
+template <typename Features, typename Confusion, typename OutputIterator>
+OutputIterator repair_ocr(const std::string &x, OutputIterator out, size_t max_cost = BOOST_CHECKDIGIT_OCR_MAX_COST)
+{
+  Confusion confusion;
+  std::vector<ocr_reading> readings;
+  std::vector<size_t> counts;
+  ocr_reading character[BOOST_CHECKDIGIT_OCR_MAX_READINGS];
+  for(std::string::const_iterator it = x.begin(); it != x.end(); ++it)
+  {
+    size_t count = confusion(*it, character);
+    if(count == 0)
+      continue;
+    readings.insert(readings.end(), character, character + BOOST_CHECKDIGIT_OCR_MAX_READINGS);
+    counts.push_back(count);
+  }
+  size_t n = counts.size();
+  if(n == 0 || Features::size_policy::overflow(n))
+    return out;
+
+  bool forward = boost::is_base_of<forward_traversal, Features>::value;
+  if(!forward)
+  {
+    std::reverse(counts.begin(), counts.end());
+    for(size_t pos = 0; pos < n / 2; ++pos)
+      std::swap_ranges(readings.begin() + pos * BOOST_CHECKDIGIT_OCR_MAX_READINGS,
+                       readings.begin() + (pos + 1) * BOOST_CHECKDIGIT_OCR_MAX_READINGS,
+                       readings.begin() + (n - 1 - pos) * BOOST_CHECKDIGIT_OCR_MAX_READINGS);
+  }
+
+  std::vector<std::vector<size_t> > results;
+  std::vector<size_t> costs;
+  detail::ocr_search<Features> search(readings, counts, max_cost, results, costs);
+  search.run();
+
+  std::vector<ocr_candidate> candidates(results.size());
+  for(size_t i = 0; i < results.size(); ++i)
+  {
+    candidates[i].cost = costs[i];
+    candidates[i].sequence.resize(n);
+    for(size_t pos = 0; pos < n; ++pos)
+    {
+      size_t value = results[i][pos];
+      candidates[i].sequence[forward ? pos : n - 1 - pos] = value == 10 ? 'X' : static_cast<char>('0' + value);
+    }
+  }
+  std::sort(candidates.begin(), candidates.end());
+  return std::copy(candidates.begin(), candidates.end(), out);
+}
+
+}} // namespace boost   namespace checkdigit
+#endif // BOOST_CHECKDIGIT_OCR_REPAIR_HPP
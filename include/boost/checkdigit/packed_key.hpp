@@ -0,0 +1,253 @@
+//  Boost checks/packed_key.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief Validate a sequence and pack its digits into an integer key during the same traversal.
+
+    \details The key policy receives each value of the traversal: from the least significant digit for a reverse
+    traversal, from the most significant one for a forward traversal. The check digit can be left out of the key,
+    so the sequences of a scheme are stored as their payloads. The keys are compared as the sequences: two sequences
+    of the same size have the same key if and only if they are equal.
+*/
+
+#ifndef BOOST_CHECKDIGIT_PACKED_KEY_HPP
+#define BOOST_CHECKDIGIT_PACKED_KEY_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+#include <iterator>
+#include <boost/cstdint.hpp>
+#include <boost/type_traits/is_base_of.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <boost/checkdigit/basic_checks.hpp>
+#include <boost/checkdigit/precheck.hpp>
+#include <boost/checkdigit/traversal.hpp>
+
+namespace boost {
+    namespace checkdigit{
+
+/*!
+  \brief Key policy packing the digits as the binary value of the number (at most 19 digits).
+*/
+struct binary_key
+{
+  typedef boost::uint64_t type;
+  static const size_t max_digits = 19;
+  static const size_t max_value = 9;
+
+  type key;
+  type power;
+
+  binary_key() : key(0), power(1)
+  {}
+
+  void push_low(size_t value)
+  {
+    key += value * power;
+    power *= 10;
+  }
+
+  void push_high(size_t value)
+  {
+    key = key * 10 + value;
+  }
+
+  type value() const
+  {
+    return key;
+  }
+};
+
+/*!
+  \brief Key policy packing the digits as binary-coded decimal, a nibble per digit (at most 16 digits).
+  The value 10 of a check digit 'X' is packed as the nibble 0xA.
+*/
+struct bcd_key
+{
+  typedef boost::uint64_t type;
+  static const size_t max_digits = 16;
+  static const size_t max_value = 15;
+
+  type key;
+  size_t shift;
+
+  bcd_key() : key(0), shift(0)
+  {}
+
+  void push_low(size_t value)
+  {
+    key |= type(value) << shift;
+    shift += 4;
+  }
+
+  void push_high(size_t value)
+  {
+    key = key << 4 | value;
+  }
+
+  type value() const
+  {
+    return key;
+  }
+};
+
+/*!
+  \brief A key of 128 bits.
+*/
+struct key128
+{
+  boost::uint64_t high;
+  boost::uint64_t low;
+
+  bool operator==(const key128 &other) const
+  {
+    return high == other.high && low == other.low;
+  }
+
+  bool operator<(const key128 &other) const
+  {
+    return high < other.high || (high == other.high && low < other.low);
+  }
+};
+
+/*!
+  \brief Key policy packing the digits as binary-coded decimal on 128 bits (at most 32 digits).
+*/
+struct bcd128_key
+{
+  typedef key128 type;
+  static const size_t max_digits = 32;
+  static const size_t max_value = 15;
+
+  type key;
+  size_t shift;
+
+  bcd128_key() : shift(0)
+  {
+    key.high = key.low = 0;
+  }
+
+  void push_low(size_t value)
+  {
+    if(shift < 64)
+      key.low |= boost::uint64_t(value) << shift;
+    else
+      key.high |= boost::uint64_t(value) << (shift - 64);
+    shift += 4;
+  }
+
+  void push_high(size_t value)
+  {
+    key.high = key.high << 4 | key.low >> 60;
+    key.low = key.low << 4 | value;
+  }
+
+  type value() const
+  {
+    return key;
+  }
+};
+
+namespace detail
+{
+
+template <typename Key>
+void push_key(Key &key, size_t value, boost::true_type)
+{
+  key.push_low(value);
+}
+
+template <typename Key>
+void push_key(Key &key, size_t value, boost::false_type)
+{
+  key.push_high(value);
+}
+
+} // namespace detail
+
+/*!
+    \brief Validate a sequence and pack its values into a key.
+
+    \tparam features is the features type of the sequence.
+    \tparam Key is the key policy (binary_key, bcd_key or bcd128_key).
+    \param x is the range of the values of the sequence (for example make_precheck<digit>(s)).
+    \param key receives the key of a valid sequence, it is left untouched otherwise.
+    \param strip_checkdigit tells if the check digit(s) are left out of the key.
+
+    \returns @c true if the sequence is valid and fits in the key, @c false otherwise.
+*/
+template <typename features,
+          typename Key,
+          typename range>
+bool check_and_pack(const range &x, typename Key::type &key, bool strip_checkdigit = false)
+{
+  typedef typename features::checksum::checkdigit_detail checkdigit_detail;
+  typedef boost::integral_constant<bool, boost::is_base_of<reverse_traversal, features>::value> reverse;
+
+  Key packer;
+  size_t packed = 0;
+  typename features::checksum::processor process;
+  size_t checksum = 0;
+  boost::checkdigit::detail::simple_counter::type counter = boost::checkdigit::detail::simple_counter()();
+  typename features::template iterator<const range>::type begin = features::begin(x);
+  typename features::template iterator<const range>::type end = features::end(x);
+  for(; begin != end && features::size_policy::check(*counter); ++begin, ++counter)
+  {
+    size_t value = *begin;
+    checksum = process(checksum, value, *counter);
+    if(strip_checkdigit && *counter >= checkdigit_detail::pos && *counter < checkdigit_detail::pos + checkdigit_detail::size)
+      continue;
+    if(value > Key::max_value || packed == Key::max_digits)
+      return false;
+    detail::push_key(packer, value, reverse());
+    ++packed;
+  }
+  if(begin != end || features::size_policy::overflow(*counter))
+    return false;
+  if(!typename features::checksum::validate_checkdigit()(checksum))
+    return false;
+  key = packer.value();
+  return true;
+}
+
+/*!
+    \brief Validate a collection of sequences and write their keys.
+
+    \tparam features is the features type of the sequences.
+    \tparam Key is the key policy.
+    \tparam Precheck is the precheck applied on each sequence (for example digit).
+    \tparam Iterator must meet the RandomAccessIterator requirements, its values are ranges of characters.
+    \param first is the first sequence.
+    \param last is the end of the sequences.
+    \param keys receives the key of each sequence, a value-initialized key for an invalid sequence.
+    \param valid receives the result of each sequence.
+    \param strip_checkdigit tells if the check digit(s) are left out of the keys.
+
+    \returns The number of valid sequences.
+*/
+template <typename features,
+          typename Key,
+          typename Precheck,
+          typename Iterator>
+size_t check_and_pack(Iterator first, Iterator last, typename Key::type *keys, bool *valid, bool strip_checkdigit = false)
+{
+  size_t valid_count = 0;
+  for(size_t i = 0; first != last; ++first, ++i)
+  {
+    keys[i] = typename Key::type();
+    valid[i] = check_and_pack<features, Key>(make_precheck<Precheck>(*first), keys[i], strip_checkdigit);
+    valid_count += valid[i];
+  }
+  return valid_count;
+}
+
+}} // namespace boost   namespace checkdigit
+#endif // BOOST_CHECKDIGIT_PACKED_KEY_HPP
@@ -0,0 +1,226 @@
+//  Boost checks/pan_scanner.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief This file provides a scanner discovering the card numbers (PAN) in unstructured text.
+
+    \details A candidate is a maximal run of 13 to 19 digits, in which a digit may be followed by a single space or hyphen.
+    A candidate is reported if it matches the prefix and the size of a Visa, Mastercard or American Express number and
+    if its Luhn check digit is correct. The text can be given in several chunks: a candidate spanning two chunks is found.
+*/
+
+#ifndef BOOST_CHECKDIGIT_PAN_SCANNER_HPP
+#define BOOST_CHECKDIGIT_PAN_SCANNER_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+#include <cstring>
+#include <boost/cstdint.hpp>
+
+#include <boost/checkdigit/luhn.hpp>
+#include <boost/checkdigit/visa.hpp>
+#include <boost/checkdigit/mastercard.hpp>
+#include <boost/checkdigit/amex.hpp>
+
+/*!
+  \brief This macro defines the minimal number of digits of a candidate card number.
+*/
+#define PAN_MIN_SIZE 13
+/*!
+  \brief This macro defines the maximal number of digits of a candidate card number.
+*/
+#define PAN_MAX_SIZE 19
+
+namespace boost {
+    namespace checkdigit{
+
+/*!
+  \brief The card brands recognized by pan_scanner.
+*/
+enum pan_brand
+{
+  visa_pan,
+  mastercard_pan,
+  amex_pan
+};
+
+/*!
+  \brief A card number found by pan_scanner.
+*/
+struct pan_match
+{
+  //! The offset of the first digit from the beginning of the stream.
+  size_t offset;
+  //! The number of characters from the first to the last digit, separators included.
+  size_t size;
+  pan_brand brand;
+};
+
+namespace detail
+{
+
+// Non-zero if one of the bytes of the word is an ASCII digit, computed on the 8 bytes at once.
+inline boost::uint64_t has_digit(boost::uint64_t x)
+{
+  const boost::uint64_t ones = 0x0101010101010101ull;
+  const boost::uint64_t low7 = 0x7F7F7F7F7F7F7F7Full;
+  boost::uint64_t low = x & low7;
+  // On the 7 low bits of each byte, adding 0x7F - '9' sets the high bit if the byte is above '9',
+  // adding 0x80 - '0' sets it if the byte is at least '0'; neither addition carries into the next byte.
+  boost::uint64_t above_9 = (low + ones * (0x7F - '9')) & ~low7;
+  boost::uint64_t from_0 = (low + ones * (0x80 - '0')) & ~low7;
+  return from_0 & ~above_9 & ~x & ~low7;
+}
+
+} // namespace detail
+
+/*!
+  \brief Streaming scanner of card numbers.
+
+  \details Call scan on each chunk of the stream, then finish at the end of the stream.
+*/
+class pan_scanner
+{
+  char digits[PAN_MAX_SIZE + 1];
+  size_t digit_count;      // Number of digits of the current run (may exceed PAN_MAX_SIZE).
+  size_t run_offset;       // Offset of the first digit of the current run.
+  size_t run_end;          // Offset following the last digit of the current run.
+  bool in_run;
+  bool after_separator;
+  size_t position;         // Offset of the beginning of the next chunk.
+
+  template <typename OutputIterator>
+  void end_run(OutputIterator &out)
+  {
+    in_run = false;
+    if(digit_count < PAN_MIN_SIZE || digit_count > PAN_MAX_SIZE)
+      return;
+
+    pan_brand brand;
+    if(digits[0] == '4' && digit_count == VISA_SIZE)
+      brand = visa_pan;
+    else if(digits[0] == '3' && (digits[1] == '4' || digits[1] == '7') && digit_count == AMEX_SIZE)
+      brand = amex_pan;
+    else if(digit_count == MASTERCARD_SIZE && is_mastercard_prefix())
+      brand = mastercard_pan;
+    else
+      return;
+
+    luhn_processor process;
+    size_t checksum = 0;
+    for(size_t pos = 0; pos < digit_count; ++pos)
+      checksum = process(checksum, digits[digit_count - 1 - pos] - '0', pos);
+    if(checksum % 10 != 0)
+      return;
+
+    pan_match match = { run_offset, run_end - run_offset, brand };
+    *out++ = match;
+  }
+
+  bool is_mastercard_prefix() const
+  {
+    // 51-55 or 2221-2720.
+    if(digits[0] == '5')
+      return digits[1] >= '1' && digits[1] <= '5';
+    if(digits[0] != '2')
+      return false;
+    int prefix = (digits[1] - '0') * 100 + (digits[2] - '0') * 10 + (digits[3] - '0');
+    return prefix >= 221 && prefix <= 720;
+  }
+
+public:
+  pan_scanner()
+  : digit_count(0), run_offset(0), run_end(0), in_run(false), after_separator(false), position(0)
+  {}
+
+  /*!
+    \brief Scan the next chunk of the stream.
+
+    \tparam OutputIterator must accept pan_match values.
+    \param data is the chunk.
+    \param size is the size of the chunk.
+    \param out receives the card numbers ending in this chunk. A card number whose last digit is at the end of the chunk is reported by a next call or by finish.
+  */
+  template <typename OutputIterator>
+  OutputIterator scan(const char *data, size_t size, OutputIterator out)
+  {
+    size_t i = 0;
+    while(i < size)
+    {
+      // Out of a run, skip 8 characters at a time while there is no digit.
+      if(!in_run)
+      {
+        for(; i + 8 <= size; i += 8)
+        {
+          boost::uint64_t word;
+          std::memcpy(&word, data + i, 8);
+          if(detail::has_digit(word))
+            break;
+        }
+        if(i == size)
+          break;
+      }
+
+      char c = data[i];
+      if(c >= '0' && c <= '9')
+      {
+        if(!in_run)
+        {
+          in_run = true;
+          digit_count = 0;
+          run_offset = position + i;
+        }
+        if(digit_count < PAN_MAX_SIZE + 1)
+          digits[digit_count] = c;
+        ++digit_count;
+        run_end = position + i + 1;
+        after_separator = false;
+      }
+      else if(in_run && (c == ' ' || c == '-') && !after_separator)
+        after_separator = true;
+      else if(in_run)
+        end_run(out);
+      ++i;
+    }
+    position += size;
+    return out;
+  }
+
+  /*!
+    \brief Signal the end of the stream and report the card number ending it, if any.
+  */
+  template <typename OutputIterator>
+  OutputIterator finish(OutputIterator out)
+  {
+    if(in_run)
+      end_run(out);
+    position = 0;
+    return out;
+  }
+};
+
+/*!
+    \brief Find the card numbers in a text.
+
+    \tparam OutputIterator must accept pan_match values.
+    \param data is the text.
+    \param size is the size of the text.
+    \param out receives the card numbers found.
+*/
+template <typename OutputIterator>
+OutputIterator scan_pan(const char *data, size_t size, OutputIterator out)
+{
+  pan_scanner scanner;
+  out = scanner.scan(data, size, out);
+  return scanner.finish(out);
+}
+
+}} // namespace boost   namespace checkdigit
+#endif // BOOST_CHECKDIGIT_PAN_SCANNER_HPP
@@ -0,0 +1,288 @@
+//  Boost checks/parallel.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief Validate or compute the check digits of large collections of sequences on several threads.
+
+    \details The collection is split into chunks of a size multiple of BOOST_CHECKDIGIT_CHUNK_ALIGNMENT sequences.
+    The chunks are scheduled dynamically: the threads take the next chunk from a shared atomic counter until there is
+    none left, so a thread finishing early takes the chunks the others have not reached yet. This is not work stealing,
+    there is no per-thread queue. The validation results are written into a bitmap; the chunk boundaries are aligned on
+    the 64 bytes cache lines of the bitmap, wherever it is allocated, so that two threads never write into the same line.
+*/
+
+#ifndef BOOST_CHECKDIGIT_PARALLEL_HPP
+#define BOOST_CHECKDIGIT_PARALLEL_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <iterator>
+#include <algorithm>
+#include <boost/cstdint.hpp>
+
+#include <boost/checkdigit/basic_checks.hpp>
+#include <boost/checkdigit/precheck.hpp>
+
+#if __cplusplus >= 201703L
+#include <execution>
+#include <type_traits>
+#endif
+
+/*! \def BOOST_CHECKDIGIT_CHUNK_ALIGNMENT
+    \brief The number of sequences whose results fill a 64 bytes cache line of the bitmap (8 words of 64 bits).
+*/
+#define BOOST_CHECKDIGIT_CHUNK_ALIGNMENT 512
+
+/*! \def BOOST_CHECKDIGIT_DEFAULT_CHUNK_SIZE
+    \brief The default number of sequences of a chunk, small enough for the sequences of a chunk to stay in the cache.
+*/
+#define BOOST_CHECKDIGIT_DEFAULT_CHUNK_SIZE 16384
+
+namespace boost {
+  namespace checkdigit{
+
+/*!
+  \brief The word type of the validation bitmaps: the bit i % 64 of the word i / 64 is set if the sequence i is valid.
+*/
+typedef boost::uint64_t bitmap_word;
+
+/*!
+  \brief Returns the number of bitmap words needed for count results.
+*/
+inline size_t bitmap_size(size_t count)
+{
+  return (count + 63) / 64;
+}
+
+/*!
+  \brief Test the result of the sequence i in a bitmap.
+*/
+inline bool bitmap_test(const bitmap_word *bitmap, size_t i)
+{
+  return (bitmap[i / 64] >> (i % 64)) & 1;
+}
+
+namespace detail
+{
+
+// The chunk c covers [0, head) if c is 0, [head + (c - 1) * chunk_size, head + c * chunk_size) otherwise.
+template <typename Function>
+struct counter_worker
+{
+  Function &function;
+  std::atomic<size_t> &next_chunk;
+  size_t chunks;
+  size_t head;
+  size_t chunk_size;
+  size_t count;
+
+  void operator()() const
+  {
+    for(size_t chunk = next_chunk.fetch_add(1); chunk < chunks; chunk = next_chunk.fetch_add(1))
+    {
+      size_t begin = chunk == 0 ? 0 : head + (chunk - 1) * chunk_size;
+      function(begin, (std::min)(count, head + chunk * chunk_size));
+    }
+  }
+};
+
+/*!
+  \brief Returns the number of sequences before the first cache line boundary of bitmap, a multiple of 64 in [64, BOOST_CHECKDIGIT_CHUNK_ALIGNMENT].
+*/
+inline size_t bitmap_head(const bitmap_word *bitmap)
+{
+  size_t words = (BOOST_CHECKDIGIT_CHUNK_ALIGNMENT / 64) - (reinterpret_cast<std::size_t>(bitmap) % 64) / sizeof(bitmap_word);
+  return words * 64;
+}
+
+/*!
+  \brief Call function(begin, end) on every chunk of [0, count) on threads threads (the calling thread included).
+  The first chunk holds head sequences (chunk_size if head is 0), so the next ones start on a cache line of the bitmap.
+*/
+template <typename Function>
+void run_chunks(size_t count, size_t chunk_size, size_t threads, Function function, size_t head = 0)
+{
+  chunk_size = (chunk_size + BOOST_CHECKDIGIT_CHUNK_ALIGNMENT - 1) / BOOST_CHECKDIGIT_CHUNK_ALIGNMENT * BOOST_CHECKDIGIT_CHUNK_ALIGNMENT;
+  if(chunk_size == 0)
+    chunk_size = BOOST_CHECKDIGIT_CHUNK_ALIGNMENT;
+  if(head == 0 || head == BOOST_CHECKDIGIT_CHUNK_ALIGNMENT)
+    head = chunk_size;
+  if(threads == 0)
+    threads = (std::max)(1u, std::thread::hardware_concurrency());
+
+  size_t chunks = count <= head ? 1 : 1 + (count - head + chunk_size - 1) / chunk_size;
+  threads = (std::min)(threads, chunks);
+
+  std::atomic<size_t> next_chunk(0);
+  counter_worker<Function> worker = { function, next_chunk, chunks, head, chunk_size, count };
+  std::vector<std::thread> pool;
+  pool.reserve(threads - 1);
+  try
+  {
+    for(size_t i = 1; i < threads; ++i)
+      pool.push_back(std::thread(worker));
+  }
+  catch(...)
+  {
+    // The started threads stop at their next chunk and must be joined before the pool is destroyed.
+    next_chunk = chunks;
+    for(size_t i = 0; i < pool.size(); ++i)
+      pool[i].join();
+    throw;
+  }
+  worker();
+  for(size_t i = 0; i < pool.size(); ++i)
+    pool[i].join();
+}
+
+template <typename Features, typename Precheck, typename Iterator>
+struct check_chunk
+{
+  Iterator sequences;
+  bitmap_word *bitmap;
+
+  // begin is a multiple of 64, so the chunk owns its words.
+  void operator()(size_t begin, size_t end) const
+  {
+    for(size_t word = begin; word < end; word += 64)
+    {
+      bitmap_word bits = 0;
+      size_t last = (std::min)(end, word + 64);
+      for(size_t i = word; i < last; ++i)
+        bits |= bitmap_word(check_sequence<Features>(make_precheck<Precheck>(sequences[i]))) << (i - word);
+      bitmap[word / 64] = bits;
+    }
+  }
+};
+
+template <typename Features, typename Precheck, typename Iterator, typename OutputIterator>
+struct compute_chunk
+{
+  Iterator sequences;
+  OutputIterator checkdigits;
+
+  void operator()(size_t begin, size_t end) const
+  {
+    for(size_t i = begin; i < end; ++i)
+      checkdigits[i] = compute_checkdigit<Features>(make_precheck<Precheck>(sequences[i]));
+  }
+};
+
+} // namespace detail
+
+/*!
+    \brief Validate a collection of sequences on several threads.
+
+    \tparam Features is the features type of the sequences (for example luhn or ean13 features).
+    \tparam Precheck is the precheck applied on each sequence (digit by default, as for the std::string overloads).
+    \tparam Iterator must meet the RandomAccessIterator requirements, its values are ranges of characters.
+    \param first is the first sequence.
+    \param last is the end of the sequences.
+    \param bitmap receives the results, it must hold bitmap_size(last - first) words.
+    \param threads is the number of threads, 0 for the number of hardware threads.
+    \param chunk_size is the number of sequences of a chunk, rounded up to a multiple of BOOST_CHECKDIGIT_CHUNK_ALIGNMENT.
+
+    \returns The number of valid sequences.
+*/
+template <typename Features, typename Precheck, typename Iterator>
+size_t check_sequence(Iterator first, Iterator last, bitmap_word *bitmap,
+                      size_t threads = 0, size_t chunk_size = BOOST_CHECKDIGIT_DEFAULT_CHUNK_SIZE)
+{
+  size_t count = std::distance(first, last);
+  detail::check_chunk<Features, Precheck, Iterator> chunk = { first, bitmap };
+  detail::run_chunks(count, chunk_size, threads, chunk, detail::bitmap_head(bitmap));
+
+  size_t valid = 0;
+  for(size_t i = 0; i < bitmap_size(count); ++i)
+    for(bitmap_word w = bitmap[i]; w != 0; w &= w - 1)
+      ++valid;
+  return valid;
+}
+
+/*!
+    \brief Calculate the check digits of a collection of sequences on several threads.
+
+    \tparam Features is the features type of the sequences.
+    \tparam Precheck is the precheck applied on each sequence.
+    \tparam Iterator must meet the RandomAccessIterator requirements, its values are ranges of characters.
+    \tparam OutputIterator must meet the RandomAccessIterator requirements, its values are assignable from size_t.
+    \param first is the first sequence.
+    \param last is the end of the sequences.
+    \param checkdigits receives the check digit of each sequence, or bad_sequence.
+    \param threads is the number of threads, 0 for the number of hardware threads.
+    \param chunk_size is the number of sequences of a chunk.
+*/
+template <typename Features, typename Precheck, typename Iterator, typename OutputIterator>
+void compute_checkdigit(Iterator first, Iterator last, OutputIterator checkdigits,
+                        size_t threads = 0, size_t chunk_size = BOOST_CHECKDIGIT_DEFAULT_CHUNK_SIZE)
+{
+  detail::compute_chunk<Features, Precheck, Iterator, OutputIterator> chunk = { first, checkdigits };
+  detail::run_chunks(std::distance(first, last), chunk_size, threads, chunk);
+}
+
+#if __cplusplus >= 201703L
+
+/*!
+    \brief Validate a collection of sequences with a standard execution policy, one cache line of the bitmap per element access.
+
+    \tparam Features is the features type of the sequences.
+    \tparam Precheck is the precheck applied on each sequence.
+    \param policy is the standard execution policy (std::execution::par, par_unseq...).
+    \param first is the first sequence.
+    \param last is the end of the sequences.
+    \param bitmap receives the results, it must hold bitmap_size(last - first) words.
+*/
+template <typename Features, typename Precheck, typename ExecutionPolicy, typename Iterator,
+          typename = typename std::enable_if<std::is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value>::type>
+void check_sequence(ExecutionPolicy &&policy, Iterator first, Iterator last, bitmap_word *bitmap)
+{
+  size_t count = std::distance(first, last);
+  // An element writes the words of one cache line of the bitmap, so two threads never share a line.
+  size_t head = detail::bitmap_head(bitmap);
+  std::vector<size_t> lines(count <= head ? 1 : 1 + (count - head + BOOST_CHECKDIGIT_CHUNK_ALIGNMENT - 1) / BOOST_CHECKDIGIT_CHUNK_ALIGNMENT);
+  for(size_t i = 0; i < lines.size(); ++i)
+    lines[i] = i;
+  detail::check_chunk<Features, Precheck, Iterator> chunk = { first, bitmap };
+  std::for_each(std::forward<ExecutionPolicy>(policy), lines.begin(), lines.end(), [&](size_t line)
+  {
+    size_t begin = line == 0 ? 0 : head + (line - 1) * BOOST_CHECKDIGIT_CHUNK_ALIGNMENT;
+    chunk(begin, (std::min)(count, head + line * BOOST_CHECKDIGIT_CHUNK_ALIGNMENT));
+  });
+}
+
+/*!
+    \brief Calculate the check digits of a collection of sequences with a standard execution policy.
+
+    \tparam Features is the features type of the sequences.
+    \tparam Precheck is the precheck applied on each sequence.
+    \param policy is the standard execution policy.
+    \param first is the first sequence.
+    \param last is the end of the sequences.
+    \param checkdigits receives the check digit of each sequence, or bad_sequence.
+*/
+template <typename Features, typename Precheck, typename ExecutionPolicy, typename Iterator, typename OutputIterator,
+          typename = typename std::enable_if<std::is_execution_policy<typename std::decay<ExecutionPolicy>::type>::value>::type>
+void compute_checkdigit(ExecutionPolicy &&policy, Iterator first, Iterator last, OutputIterator checkdigits)
+{
+  std::transform(std::forward<ExecutionPolicy>(policy), first, last, checkdigits, [](const typename std::iterator_traits<Iterator>::value_type &x)
+  {
+    return compute_checkdigit<Features>(make_precheck<Precheck>(x));
+  });
+}
+
+#endif // __cplusplus >= 201703L
+
+} // namespace checkdigit
+} // namespace boost
+
+#endif // BOOST_CHECKDIGIT_PARALLEL_HPP
@@ -0,0 +1,316 @@
+//  Boost checks/partial_checksum.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief Provides partial checksum states that can be computed independently on the pieces of a sequence and combined.
+
+    \details partial_checksum<Processor> is specialized for each processor. Its state describes a piece of a sequence
+    whose positions are counted from 0, as if the piece was alone. The combination of the state of a piece and of the state
+    of the piece following it in the traversal order shifts the positions of the second piece by the length of the first one.
+    The combination is associative and the empty state is its identity, so the pieces can be reduced in any grouping
+    (chunks of threads, lanes, tree reduction) as long as their order is kept.
+
+    Each specialization provides:
+    - state: the partial state, empty when value-initialized with the static function empty();
+    - push(state, value): append a value to the piece (at the position following the last one);
+    - combine(first, second): the state of the piece first followed by the piece second;
+    - checksum(state): the checksum of the sequence, as computed by the processor, or a value congruent to it
+      modulo the modulus of the scheme.
+*/
+
+#ifndef BOOST_CHECKDIGIT_PARTIAL_CHECKSUM_HPP
+#define BOOST_CHECKDIGIT_PARTIAL_CHECKSUM_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+
+#include <boost/checkdigit/weight.hpp>
+#include <boost/checkdigit/weighted_sum.hpp>
+#include <boost/checkdigit/positional_weight.hpp>
+#include <boost/checkdigit/luhn.hpp>
+#include <boost/checkdigit/verhoeff.hpp>
+#include <boost/checkdigit/modulus97_10.hpp>
+
+namespace boost {
+    namespace checkdigit{
+
+/*! \class partial_checksum
+    \brief Associative partial state of the checksum computed by Processor, specialized for each processor.
+*/
+template <typename Processor>
+struct partial_checksum;
+
+/*!
+  \brief Partial state of a weighted sum with periodic weights: the sums of the values by position modulo the period.
+*/
+template <BOOST_PP_ENUM_PARAMS(BOOST_CHECKDIGIT_LIMIT_WEIGHTS, size_t weight_value)>
+struct partial_checksum<weighted_sum<weight<BOOST_PP_ENUM_PARAMS(BOOST_CHECKDIGIT_LIMIT_WEIGHTS, weight_value)> > >
+{
+  typedef weight<BOOST_PP_ENUM_PARAMS(BOOST_CHECKDIGIT_LIMIT_WEIGHTS, weight_value)> weight_type;
+
+  struct state
+  {
+    size_t sums[weight_type::size];
+    size_t length;
+  };
+
+  static state empty()
+  {
+    state s = state();
+    return s;
+  }
+
+  static void push(state &s, size_t value)
+  {
+    s.sums[s.length % weight_type::size] += value;
+    ++s.length;
+  }
+
+  static state combine(const state &first, const state &second)
+  {
+    state s = first;
+    size_t shift = first.length % weight_type::size;
+    for(size_t r = 0; r < weight_type::size; ++r)
+      s.sums[(r + shift) % weight_type::size] += second.sums[r];
+    s.length += second.length;
+    return s;
+  }
+
+  static size_t checksum(const state &s)
+  {
+    size_t result = 0;
+    for(size_t r = 0; r < weight_type::size; ++r)
+      result += s.sums[r] * weight_type::at(r);
+    return result;
+  }
+};
+
+/*!
+  \brief Partial state of a weighted sum with arithmetic weights: the sum of the values and the sum of the values multiplied by their position.
+*/
+template <size_t first_weight, size_t step>
+struct partial_checksum<weighted_sum<arithmetic_weight<first_weight, step> > >
+{
+  struct state
+  {
+    size_t sum;
+    size_t position_sum;
+    size_t length;
+  };
+
+  static state empty()
+  {
+    state s = state();
+    return s;
+  }
+
+  static void push(state &s, size_t value)
+  {
+    s.sum += value;
+    s.position_sum += value * s.length;
+    ++s.length;
+  }
+
+  static state combine(const state &first, const state &second)
+  {
+    state s = { first.sum + second.sum,
+                first.position_sum + second.position_sum + first.length * second.sum,
+                first.length + second.length };
+    return s;
+  }
+
+  static size_t checksum(const state &s)
+  {
+    return first_weight * s.sum + step * s.position_sum;
+  }
+};
+
+template <size_t first_weight>
+struct partial_checksum<weighted_sum<linear_weight<first_weight> > >
+  : partial_checksum<weighted_sum<arithmetic_weight<first_weight, 1> > >
+{};
+
+/*!
+  \brief Partial state of a weighted sum with geometric weights: the checksum of the piece and ratio^length.
+*/
+template <size_t first_weight, size_t ratio>
+struct partial_checksum<weighted_sum<geometric_weight<first_weight, ratio> > >
+{
+  struct state
+  {
+    size_t sum;
+    size_t factor;
+  };
+
+  static state empty()
+  {
+    state s = { 0, 1 };
+    return s;
+  }
+
+  static void push(state &s, size_t value)
+  {
+    s.sum += value * first_weight * s.factor;
+    s.factor *= ratio;
+  }
+
+  static state combine(const state &first, const state &second)
+  {
+    state s = { first.sum + second.sum * first.factor, first.factor * second.factor };
+    return s;
+  }
+
+  static size_t checksum(const state &s)
+  {
+    return s.sum;
+  }
+};
+
+/*!
+  \brief Partial state of the Luhn algorithm: the checksums of the piece starting at an even and at an odd position.
+*/
+template <>
+struct partial_checksum<luhn_processor>
+{
+  struct state
+  {
+    size_t sums[2]; // sums[p] is the checksum if the piece starts at a position of parity p.
+    size_t length;
+  };
+
+  static state empty()
+  {
+    state s = state();
+    return s;
+  }
+
+  static void push(state &s, size_t value)
+  {
+    luhn_processor process;
+    s.sums[0] = process(s.sums[0], value, s.length);
+    s.sums[1] = process(s.sums[1], value, s.length + 1);
+    ++s.length;
+  }
+
+  static state combine(const state &first, const state &second)
+  {
+    size_t odd = first.length & 1;
+    state s = { { first.sums[0] + second.sums[odd], first.sums[1] + second.sums[!odd] },
+                first.length + second.length };
+    return s;
+  }
+
+  static size_t checksum(const state &s)
+  {
+    return s.sums[0];
+  }
+};
+
+/*!
+  \brief Partial state of the Verhoeff algorithm: the products in the dihedral group D5 of the piece starting at each position modulo 8.
+
+  \remarks The operation of the table d is associative, the permutation p only depends on the position modulo 8.
+*/
+template <>
+struct partial_checksum<verhoeff_processor>
+{
+  struct state
+  {
+    unsigned char products[8]; // products[s] is the checksum if the piece starts at a position congruent to s modulo 8.
+    size_t length;
+  };
+
+  static state empty()
+  {
+    state s = state();
+    return s;
+  }
+
+  static void push(state &s, size_t value)
+  {
+    for(size_t shift = 0; shift < 8; ++shift)
+      s.products[shift] = verhoeff_processor::d[s.products[shift]][verhoeff_processor::p[(s.length + shift) % 8][value]];
+    ++s.length;
+  }
+
+  static state combine(const state &first, const state &second)
+  {
+    state s;
+    for(size_t shift = 0; shift < 8; ++shift)
+      s.products[shift] = verhoeff_processor::d[first.products[shift]][second.products[(shift + first.length) % 8]];
+    s.length = first.length + second.length;
+    return s;
+  }
+
+  static size_t checksum(const state &s)
+  {
+    return s.products[0];
+  }
+};
+
+/*!
+  \brief Partial state of the modulus 97-10 algorithm: the checksum of the piece modulus 97 and 10^length modulus 97.
+
+  \remarks Unlike mod97_10_processor, the state has no hidden weight: the weight of the second piece is the factor of the first one.
+*/
+template <>
+struct partial_checksum<mod97_10_processor>
+{
+  struct state
+  {
+    size_t sum;
+    size_t factor;
+  };
+
+  static state empty()
+  {
+    state s = { 0, 1 };
+    return s;
+  }
+
+  static void push(state &s, size_t value)
+  {
+    s.sum = (s.sum + value * s.factor) % 97;
+    s.factor = s.factor * 10 % 97;
+  }
+
+  static state combine(const state &first, const state &second)
+  {
+    state s = { (first.sum + second.sum * first.factor) % 97, first.factor * second.factor % 97 };
+    return s;
+  }
+
+  static size_t checksum(const state &s)
+  {
+    return s.sum;
+  }
+};
+
+/*!
+    \brief Compute the partial state of a piece of a sequence.
+
+    \tparam Processor is the processor of the checksum.
+    \tparam Iterator must meet the InputIterator requirements, its values are given in the traversal order.
+    \param first is the first value of the piece.
+    \param last is the end of the piece.
+
+    \returns The partial state of the piece.
+*/
+template <typename Processor, typename Iterator>
+typename partial_checksum<Processor>::state make_partial_checksum(Iterator first, Iterator last)
+{
+  typename partial_checksum<Processor>::state s = partial_checksum<Processor>::empty();
+  for(; first != last; ++first)
+    partial_checksum<Processor>::push(s, *first);
+  return s;
+}
+
+}} // namespace boost   namespace checkdigit
+#endif // BOOST_CHECKDIGIT_PARTIAL_CHECKSUM_HPP
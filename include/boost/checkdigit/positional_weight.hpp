@@ -0,0 +1,153 @@
+//  Boost checks/positional_weight.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief Provides non-periodic weights growing with the position of the value.
+
+    \details Unlike weight, these weights are not a repeated sequence: they are computed from the position
+    (arithmetic progression) or from the previous weight (geometric progression), without any modulus or table lookup.
+    They meet the requirements of weighted_sum.
+*/
+
+#ifndef BOOST_CHECKDIGIT_POSITIONAL_WEIGHT_HPP
+#define BOOST_CHECKDIGIT_POSITIONAL_WEIGHT_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+#include <boost/checkdigit/weighted_sum.hpp>
+
+namespace boost{
+  namespace checkdigit{
+
+/*! \class arithmetic_weight
+    \brief The weight at the position pos is first + step * pos.
+*/
+template <size_t first = 1, size_t step = 1>
+struct arithmetic_weight
+{
+  static const size_t first_value = first;
+  static const size_t step_value = step;
+
+  static size_t at(size_t value_pos)
+  {
+    return first + step * value_pos;
+  }
+};
+
+/*! \class linear_weight
+    \brief The weight at the position pos is first + pos, the weights are first, first+1, first+2...
+*/
+template <size_t first = 1>
+struct linear_weight : arithmetic_weight<first, 1>
+{};
+
+/*! \class geometric_weight
+    \brief The weight at the position pos is first * ratio^pos.
+*/
+template <size_t first = 1, size_t ratio = 2>
+struct geometric_weight
+{
+  static const size_t first_value = first;
+  static const size_t ratio_value = ratio;
+
+  static size_t at(size_t value_pos)
+  {
+    size_t w = first;
+    for(; value_pos != 0; --value_pos)
+      w *= ratio;
+    return w;
+  }
+};
+
+/*!
+  \brief Weighted sum with a geometric weight: the weight is obtained from the previous one by a multiplication.
+
+  \remarks As for mod97_10_processor, the processor keeps the current weight, the positions are expected to be consecutive (a skipped position is recomputed).
+*/
+template <size_t first, size_t ratio>
+struct weighted_sum<geometric_weight<first, ratio> >
+{
+  size_t current_weight;
+  size_t next_pos;
+
+  weighted_sum() : current_weight(first), next_pos(0)
+  {}
+
+  size_t operator()(size_t checksum, size_t value, size_t pos)
+  {
+    if(pos != next_pos)
+      current_weight = geometric_weight<first, ratio>::at(pos);
+    size_t result = checksum + value * current_weight;
+    current_weight *= ratio;
+    next_pos = pos + 1;
+    return result;
+  }
+};
+
+namespace detail
+{
+
+/*!
+  \brief Compute in a single pass the sum and the position weighted sum of a sequence, as a sum of prefix sums.
+
+  \param first is the beginning of the sequence, its values already transliterated.
+  \param last is the end of the sequence.
+  \param sum receives the sum of the values.
+  \param weighted_sum receives the sum of the values multiplied by their position from the right (the last value is at the position 0).
+  \param bound is the upper bound of the values, a value not lower than bound stops the pass.
+
+  \returns The number of values, or (size_t)-1 if a value is not lower than bound.
+
+  \remarks Each value is added to the running sum once and the running sum is added for each value on its right,
+  so there is neither multiplication nor modulus in the loop. The weighted sum from the left (the first value
+  at the position 1) is the number of values times sum minus weighted_sum.
+*/
+template <typename Iterator>
+size_t prefix_sums(Iterator first, Iterator last, size_t &sum, size_t &weighted_sum, size_t bound = (size_t)-1)
+{
+  size_t running_sum = 0;
+  size_t sum_of_sums = 0;
+  size_t count = 0;
+  for(; first != last; ++first, ++count)
+  {
+    size_t value = *first;
+    if(value >= bound)
+    {
+      sum = weighted_sum = 0;
+      return (size_t)-1;
+    }
+    running_sum += value;
+    sum_of_sums += running_sum;
+  }
+  sum = running_sum;
+  weighted_sum = sum_of_sums - running_sum;
+  return count;
+}
+
+/*!
+  \brief Compute the checksum of weighted_sum<arithmetic_weight<first, step> > with a traversal from the right, using the prefix sums.
+
+  \param begin is the beginning of the sequence, its values already transliterated.
+  \param end is the end of the sequence.
+  \param pos is the position of the last value.
+*/
+template <size_t first, size_t step, typename Iterator>
+size_t arithmetic_weighted_sum(Iterator begin, Iterator end, size_t pos = 0)
+{
+  size_t sum, weighted_sum;
+  prefix_sums(begin, end, sum, weighted_sum);
+  return (first + step * pos) * sum + step * weighted_sum;
+}
+
+} // namespace detail
+
+}} // namespace boost   namespace checkdigit
+
+#endif //BOOST_CHECKDIGIT_POSITIONAL_WEIGHT_HPP
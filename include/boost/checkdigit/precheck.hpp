@@ -22,7 +22,7 @@
 #include <boost/iterator/transform_iterator.hpp>
 
 #include <boost/checkdigit/filter.hpp>
-#include <boost/checkdigit/conversion.hpp>
+#include <boost/checkdigit/transliteration.hpp>
 
 namespace boost {
   namespace checkdigit{
@@ -127,8 +127,8 @@ struct precheck<UnaryPredicate, no_conversion_tag>
   }
 };                                   
 
-typedef precheck<digit_filter, chartodigit> digit; 
-typedef precheck<digitx_filter, chartodigitx> digitx;
+typedef precheck<digit_filter, ascii_to_digit> digit;
+typedef precheck<digitx_filter, ascii_to_digitx> digitx;
 
 } // namespace checkdigit
 } // namespace boost
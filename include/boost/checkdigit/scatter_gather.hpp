@@ -0,0 +1,130 @@
+//  Boost checks/scatter_gather.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief Validate or compute the check digit of a sequence split into several non-contiguous buffers.
+
+    \details The sequence is given as an array of segments (pointer, size), as an iovec array.
+    The segments are visited in the traversal order of the features type: from the last to the first one
+    for a reverse traversal, each segment being itself read with the traversal of the features type.
+    The processor and the position counter are shared by all the segments, so the result is the one
+    of the concatenated sequence, without copying it.
+*/
+
+#ifndef BOOST_CHECKDIGIT_SCATTER_GATHER_HPP
+#define BOOST_CHECKDIGIT_SCATTER_GATHER_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+#include <utility>
+#include <boost/range/iterator_range.hpp>
+
+#include <boost/checkdigit/basic_checks.hpp>
+#include <boost/checkdigit/precheck.hpp>
+
+namespace boost {
+    namespace checkdigit{
+
+/*!
+  \brief A contiguous part of a sequence.
+*/
+struct segment
+{
+  const char *data;
+  size_t size;
+};
+
+namespace detail
+{
+
+/*!
+  \brief Compute the checksum of the concatenation of the segments, as compute_checksum does for a single range.
+
+  \tparam SegmentIterator iterates over the segments in the traversal order of the features type.
+*/
+template <typename features,
+          typename Precheck,
+          typename SegmentIterator,
+          typename counter_iter>
+size_t compute_segments_checksum(SegmentIterator first, SegmentIterator last, counter_iter &counter)
+{
+  typedef typename Precheck::template iterator<const char*>::type iterator;
+  typedef boost::iterator_range<iterator> range;
+
+  typename features::checksum::processor process;
+  size_t checksum = 0;
+  for(; first != last; ++first)
+  {
+    std::pair<iterator, iterator> values = make_precheck<Precheck>(first->data, first->data + first->size);
+    range x(values.first, values.second);
+    typename features::template iterator<range>::type begin = features::begin(x);
+    typename features::template iterator<range>::type end = features::end(x);
+    for(; begin != end && features::size_policy::check(*counter); ++begin, ++counter)
+      checksum = process(checksum, *begin, *counter);
+    if(begin != end)
+      return bad_sequence;
+  }
+  if(features::size_policy::overflow(*counter))
+    return bad_sequence;
+  return checksum;
+}
+
+} // namespace detail
+
+/*!
+    \brief Validate a sequence split into several segments.
+
+    \tparam features is the features type of the sequence.
+    \tparam Precheck is the precheck applied on each segment (for example digit).
+    \param segments is the first segment, the segments are in the order of the sequence.
+    \param count is the number of segments.
+
+    \returns @c true if the check digit of the concatenated segments is correct, @c false otherwise.
+*/
+template <typename features,
+          typename Precheck>
+bool check_sequence(const segment *segments, size_t count)
+{
+  boost::iterator_range<const segment*> x(segments, segments + count);
+  boost::checkdigit::detail::simple_counter::type counter = boost::checkdigit::detail::simple_counter()();
+  size_t checksum = detail::compute_segments_checksum<features, Precheck>(features::begin(x), features::end(x), counter);
+  if(checksum == bad_sequence)
+    return false;
+  return typename features::checksum::validate_checkdigit()(checksum);
+}
+
+/*!
+    \brief Calculate the check digit of a sequence split into several segments.
+
+    \tparam features is the features type of the sequence.
+    \tparam Precheck is the precheck applied on each segment.
+    \param segments is the first segment, the segments are in the order of the sequence.
+    \param count is the number of segments.
+
+    \returns The check digit of the concatenated segments, or bad_sequence.
+*/
+template <typename features,
+          typename Precheck>
+size_t compute_checkdigit(const segment *segments, size_t count)
+{
+  typedef typename boost::checkdigit::detail::skip_counter<features::checksum::checkdigit_detail::pos,
+                                                       features::checksum::checkdigit_detail::size
+                                                      > counter_type;
+  typename counter_type::type counter = counter_type()();
+
+  boost::iterator_range<const segment*> x(segments, segments + count);
+  size_t checksum = detail::compute_segments_checksum<features, Precheck>(features::begin(x), features::end(x), counter);
+  if(checksum == bad_sequence)
+    return bad_sequence;
+  return typename features::checksum::make_checkdigit()(checksum);
+}
+
+}} // namespace boost   namespace checkdigit
+#endif // BOOST_CHECKDIGIT_SCATTER_GATHER_HPP
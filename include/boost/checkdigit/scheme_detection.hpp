@@ -0,0 +1,206 @@
+//  Boost checks/scheme_detection.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief Find the schemes satisfied by a sequence of unknown type with a single traversal.
+
+    \details The values are read once, from the last one, and feed four accumulators together: the Luhn sum, the
+    sum weighted by 1 and 3 (EAN, UPC), the sum weighted by 1 to 10 (ISBN-10) and the sum weighted by the powers of
+    10 modulo 97. The size of the sequence and its four first digits are kept on the way, then the length and prefix
+    rules of each features type select the schemes among the validated checksums.
+*/
+
+#ifndef BOOST_CHECKDIGIT_SCHEME_DETECTION_HPP
+#define BOOST_CHECKDIGIT_SCHEME_DETECTION_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+#include <string>
+#include <boost/range/rbegin.hpp>
+#include <boost/range/rend.hpp>
+
+#include <boost/checkdigit/precheck.hpp>
+#include <boost/checkdigit/detail/digit_kernel.hpp>
+#include <boost/checkdigit/luhn.hpp>
+#include <boost/checkdigit/visa.hpp>
+#include <boost/checkdigit/mastercard.hpp>
+#include <boost/checkdigit/amex.hpp>
+#include <boost/checkdigit/ean.hpp>
+#include <boost/checkdigit/upc.hpp>
+#include <boost/checkdigit/isbn.hpp>
+#include <boost/checkdigit/gs1.hpp>
+#include <boost/checkdigit/modulus97_10.hpp>
+
+namespace boost {
+    namespace checkdigit{
+
+/*!
+  \brief The schemes reported by detect_schemes, as bits of a scheme_set.
+*/
+enum scheme_flag
+{
+  luhn_scheme = 1 << 0,       //!< Any size, Luhn.
+  visa_scheme = 1 << 1,       //!< VISA_SIZE digits beginning by 4, Luhn.
+  mastercard_scheme = 1 << 2, //!< MASTERCARD_SIZE digits beginning by 51 to 55 or 2221 to 2720, Luhn.
+  amex_scheme = 1 << 3,       //!< AMEX_SIZE digits beginning by 34 or 37, Luhn.
+  ean8_scheme = 1 << 4,       //!< EAN8_SIZE digits, weights 1 and 3.
+  upca_scheme = 1 << 5,       //!< UPCA_SIZE digits, weights 1 and 3.
+  ean13_scheme = 1 << 6,      //!< EAN13_SIZE digits, weights 1 and 3.
+  isbn13_scheme = 1 << 7,     //!< EAN13_SIZE digits beginning by 978 or 979, weights 1 and 3.
+  gtin14_scheme = 1 << 8,     //!< GTIN14_SIZE digits, weights 1 and 3.
+  gsin_scheme = 1 << 9,       //!< GSIN_SIZE digits, weights 1 and 3.
+  sscc_scheme = 1 << 10,      //!< SSCC_SIZE digits, weights 1 and 3.
+  isbn10_scheme = 1 << 11,    //!< ISBN10_SIZE values, the last one can be 'X', modulus 11.
+  mod97_10_scheme = 1 << 12   //!< At least 3 digits, the sequence modulo 97 is 1.
+};
+
+/*!
+  \brief A set of scheme_flag.
+*/
+typedef unsigned int scheme_set;
+
+/*!
+  \brief The accumulators of a single traversal of a sequence.
+*/
+struct fused_checksum
+{
+  size_t size;          //!< The number of values.
+  size_t luhn;          //!< The checksum of luhn_processor.
+  size_t mod10;         //!< The checksum of ean_processor (weights 1 and 3).
+  size_t mod11;         //!< The checksum of the ISBN-10 processor (weights 1 to 10).
+  size_t mod97;         //!< The checksum of mod97_10_processor.
+  bool checkdigitx;     //!< @c true if the last value is 10 ('X').
+  bool other;           //!< @c true if a value other than the last one is 10.
+  unsigned char head[4];//!< The first min(size, 4) values.
+};
+
+/*!
+    \brief Compute the checksums of the supported schemes in a single traversal.
+
+    \tparam range is a range of values (for example the result of make_precheck<digitx>).
+    \param x is the sequence.
+
+    \returns The accumulators of the sequence.
+*/
+template <typename range>
+fused_checksum compute_fused_checksum(const range &x)
+{
+  typedef checksum_contribution<luhn::processor> luhn_contribution;
+  typedef checksum_contribution<ean13::checksum::processor> mod10_contribution;
+  typedef checksum_contribution<isbn10::checksum::processor> mod11_contribution;
+  typedef checksum_contribution<mod97_10_processor> mod97_contribution;
+
+  fused_checksum sums = { 0, 0, 0, 0, 0, false, false, { 0, 0, 0, 0 } };
+  typename boost::range_reverse_iterator<const range>::type begin = boost::rbegin(x);
+  typename boost::range_reverse_iterator<const range>::type end = boost::rend(x);
+  for(; begin != end; ++begin, ++sums.size)
+  {
+    size_t value = *begin;
+    if(value > 9)
+    {
+      sums.checkdigitx = sums.size == 0;
+      sums.other = sums.other || sums.size != 0;
+      sums.mod11 += mod11_contribution::at(value, sums.size);
+    }
+    else
+    {
+      sums.luhn += luhn_contribution::at(value, sums.size);
+      sums.mod10 += mod10_contribution::at(value, sums.size);
+      sums.mod11 += mod11_contribution::at(value, sums.size);
+      sums.mod97 += mod97_contribution::at(value, sums.size);
+    }
+    sums.head[3] = sums.head[2];
+    sums.head[2] = sums.head[1];
+    sums.head[1] = sums.head[0];
+    sums.head[0] = static_cast<unsigned char>(value);
+  }
+  return sums;
+}
+
+/*!
+    \brief Select the schemes satisfied by the accumulators of a sequence.
+
+    \param sums are the accumulators of the sequence.
+
+    \returns The set of the schemes whose size, prefix and check digit rules are satisfied. A sequence with an 'X'
+    can only be an ISBN-10.
+*/
+inline scheme_set detect_schemes(const fused_checksum &sums)
+{
+  if(sums.other)
+    return 0;
+  scheme_set schemes = 0;
+  if(sums.size == ISBN10_SIZE && isbn10::checksum::validate_checkdigit()(sums.mod11))
+    schemes |= isbn10_scheme;
+  if(sums.checkdigitx || sums.size < 2)
+    return schemes;
+
+  size_t prefix2 = sums.head[0] * 10 + sums.head[1];
+  size_t prefix3 = prefix2 * 10 + sums.head[2];
+  size_t prefix4 = prefix3 * 10 + sums.head[3];
+  if(luhn::validate_checkdigit()(sums.luhn))
+  {
+    schemes |= luhn_scheme;
+    if(sums.size == VISA_SIZE && sums.head[0] == 4)
+      schemes |= visa_scheme;
+    if(sums.size == MASTERCARD_SIZE && ((prefix2 >= 51 && prefix2 <= 55) || (prefix4 >= 2221 && prefix4 <= 2720)))
+      schemes |= mastercard_scheme;
+    if(sums.size == AMEX_SIZE && (prefix2 == 34 || prefix2 == 37))
+      schemes |= amex_scheme;
+  }
+  if(ean13::checksum::validate_checkdigit()(sums.mod10))
+  {
+    switch(sums.size)
+    {
+      case EAN8_SIZE: schemes |= ean8_scheme; break;
+      case UPCA_SIZE: schemes |= upca_scheme; break;
+      case EAN13_SIZE:
+        schemes |= ean13_scheme;
+        if(prefix3 == 978 || prefix3 == 979)
+          schemes |= isbn13_scheme;
+        break;
+      case GTIN14_SIZE: schemes |= gtin14_scheme; break;
+      case GSIN_SIZE: schemes |= gsin_scheme; break;
+      case SSCC_SIZE: schemes |= sscc_scheme; break;
+    }
+  }
+  if(sums.size >= 3 && sums.mod97 % 97 == 1)
+    schemes |= mod97_10_scheme;
+  return schemes;
+}
+
+/*!
+    \brief Find the schemes satisfied by a sequence.
+
+    \tparam range is a range of values (for example the result of make_precheck<digitx>).
+    \param x is the sequence.
+
+    \returns The set of the satisfied schemes.
+*/
+template <typename range>
+scheme_set detect_schemes(const range &x)
+{
+  return detect_schemes(compute_fused_checksum(x));
+}
+
+/*!
+    \brief Find the schemes satisfied by a sequence of characters, the characters other than digits and 'X' being skipped.
+
+    \param x is the sequence.
+
+    \returns The set of the satisfied schemes.
+*/
+inline scheme_set detect_schemes(const std::string &x)
+{
+  return detect_schemes(compute_fused_checksum(make_precheck<digitx>(x)));
+}
+
+}} // namespace boost   namespace checkdigit
+#endif // BOOST_CHECKDIGIT_SCHEME_DETECTION_HPP
@@ -0,0 +1,397 @@
+//  Boost checks/scheme_registry.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief Choose the scheme of a validation at runtime, by its name.
+
+    \details A scheme_validator hides the features type and the precheck of a scheme behind a virtual interface whose
+    batch function validates a whole array of sequences: the virtual call is paid once per batch and the loop on the
+    sequences is the one of the features type. The schemes only known at runtime are described by a
+    weighted_modulus_scheme (weights, modulus, transliteration table), compiled on registration into a table of the
+    contributions of every character at every position of the weights, so the validation is a lookup and an addition
+    per character.
+*/
+
+#ifndef BOOST_CHECKDIGIT_SCHEME_REGISTRY_HPP
+#define BOOST_CHECKDIGIT_SCHEME_REGISTRY_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+#include <string>
+#include <vector>
+#include <map>
+#include <boost/shared_ptr.hpp>
+
+#include <boost/checkdigit/basic_checks.hpp>
+#include <boost/checkdigit/precheck.hpp>
+#include <boost/checkdigit/luhn.hpp>
+#include <boost/checkdigit/visa.hpp>
+#include <boost/checkdigit/mastercard.hpp>
+#include <boost/checkdigit/amex.hpp>
+#include <boost/checkdigit/ean.hpp>
+#include <boost/checkdigit/upc.hpp>
+#include <boost/checkdigit/isbn.hpp>
+#include <boost/checkdigit/gs1.hpp>
+#include <boost/checkdigit/verhoeff.hpp>
+
+/*!
+  \brief This macro defines the minimal number of characters of an IBAN.
+*/
+#define IBAN_MIN_SIZE 15
+
+/*!
+  \brief This macro defines the maximal number of characters of an IBAN.
+*/
+#define IBAN_MAX_SIZE 34
+
+/*!
+  \brief This macro defines the size of a vehicle identification number.
+*/
+#define VIN_SIZE 17
+
+namespace boost {
+    namespace checkdigit{
+
+/*! \class scheme_validator
+    \brief The validation of a scheme, whatever its type.
+*/
+class scheme_validator
+{
+public:
+  virtual ~scheme_validator()
+  {}
+
+  /*!
+    \brief Validate a sequence.
+
+    \param data is the first character of the sequence.
+    \param size is the number of characters of the sequence.
+
+    \returns @c true if the sequence is valid, @c false otherwise.
+  */
+  virtual bool check(const char *data, size_t size) const = 0;
+
+  /*!
+    \brief Validate an array of sequences.
+
+    \param sequences is the first sequence.
+    \param count is the number of sequences.
+    \param valid receives the result of each sequence.
+
+    \returns The number of valid sequences.
+  */
+  virtual size_t check(const std::string *sequences, size_t count, bool *valid) const = 0;
+};
+
+namespace detail
+{
+
+// Implement the batch validation with the validation of a sequence of Derived, called without virtual dispatch.
+template <typename Derived>
+class batch_validator : public scheme_validator
+{
+public:
+  size_t check(const std::string *sequences, size_t count, bool *valid) const
+  {
+    const Derived &self = static_cast<const Derived&>(*this);
+    size_t valid_count = 0;
+    for(size_t i = 0; i < count; ++i)
+    {
+      valid[i] = self.Derived::check(sequences[i].data(), sequences[i].size());
+      valid_count += valid[i];
+    }
+    return valid_count;
+  }
+
+  using scheme_validator::check;
+};
+
+} // namespace detail
+
+/*! \class features_validator
+    \brief The validation of a features type and a precheck.
+*/
+template <typename Features, typename Precheck>
+class features_validator : public detail::batch_validator<features_validator<Features, Precheck> >
+{
+public:
+  bool check(const char *data, size_t size) const
+  {
+    return check_sequence<Features>(make_precheck<Precheck>(data, data + size));
+  }
+
+  using detail::batch_validator<features_validator<Features, Precheck> >::check;
+};
+
+/*!
+  \brief The description of a weighted sum scheme defined at runtime.
+*/
+struct weighted_modulus_scheme
+{
+  enum
+  {
+    skip = -1,   //!< The transliteration of a character ignored, as a separator.
+    invalid = -2 //!< The transliteration of a character not allowed.
+  };
+
+  //! The weight of the position pos of the traversal is weights[pos % weights.size()].
+  std::vector<size_t> weights;
+  //! The modulus of the checksum.
+  size_t modulus;
+  //! A sequence is valid if its checksum modulo the modulus is the remainder.
+  size_t remainder;
+  //! The number of values of a sequence, 0 for any size.
+  size_t size;
+  //! @c true if the traversal begins by the first character, @c false if it begins by the last one.
+  bool forward;
+  //! The value of each character (as an unsigned char), skip or invalid. The digits by default, the other characters being skipped.
+  std::vector<int> transliteration;
+  //! The position of the check digit in the traversal.
+  size_t checkdigit_pos;
+  //! The value of each character at the position of the check digit, skip or invalid, empty to use transliteration.
+  std::vector<int> checkdigit_transliteration;
+
+  weighted_modulus_scheme()
+  : modulus(10), remainder(0), size(0), forward(false), transliteration(256, skip), checkdigit_pos(0)
+  {
+    for(int c = '0'; c <= '9'; ++c)
+      transliteration[c] = c - '0';
+  }
+};
+
+/*! \class table_validator
+    \brief The validation of a weighted_modulus_scheme, compiled into a table of contributions.
+*/
+class table_validator : public detail::batch_validator<table_validator>
+{
+  // contributions[p * 256 + c] is (value(c) * weight(p)) % modulus, or -1 if c is not allowed. Without size, p is the
+  // position modulo the number of weights; with a size, the table has a row per position.
+  std::vector<int> contributions;
+  std::vector<int> checkdigit_contributions;
+  std::vector<unsigned char> skipped;
+  std::vector<unsigned char> checkdigit_skipped;
+  size_t period;
+  size_t modulus;
+  size_t remainder;
+  size_t size;
+  bool forward;
+  size_t checkdigit_pos;
+
+  static int contribution(int value, size_t weight, size_t modulus)
+  {
+    return value < 0 ? -1 : static_cast<int>(value * weight % modulus);
+  }
+
+  bool accumulate(unsigned char c, size_t &pos, size_t &row, size_t &checksum) const
+  {
+    bool checkdigit = pos == checkdigit_pos;
+    if(checkdigit ? checkdigit_skipped[c] : skipped[c])
+      return true;
+    if(size && pos == size)
+      return false;
+    int value = checkdigit ? checkdigit_contributions[c] : contributions[row * 256 + c];
+    if(value < 0)
+      return false;
+    checksum += value;
+    ++pos;
+    if(++row == period)
+      row = 0;
+    return true;
+  }
+
+public:
+  /*!
+    \brief Compile a scheme.
+
+    \pre scheme.weights is not empty and scheme.transliteration has 256 entries.
+  */
+  explicit table_validator(const weighted_modulus_scheme &scheme)
+  : contributions(), checkdigit_contributions(256), skipped(256), checkdigit_skipped(256),
+    period(scheme.size ? scheme.size : scheme.weights.size()), modulus(scheme.modulus), remainder(scheme.remainder),
+    size(scheme.size), forward(scheme.forward), checkdigit_pos(scheme.checkdigit_pos)
+  {
+    contributions.resize(period * 256);
+    for(size_t p = 0; p < period; ++p)
+      for(size_t c = 0; c < 256; ++c)
+        contributions[p * 256 + c] = contribution(scheme.transliteration[c], scheme.weights[p % scheme.weights.size()], modulus);
+
+    const std::vector<int> &checkdigit = scheme.checkdigit_transliteration.empty() ? scheme.transliteration
+                                                                                   : scheme.checkdigit_transliteration;
+    size_t checkdigit_weight = scheme.weights[checkdigit_pos % scheme.weights.size()];
+    for(size_t c = 0; c < 256; ++c)
+    {
+      skipped[c] = scheme.transliteration[c] == weighted_modulus_scheme::skip;
+      checkdigit_skipped[c] = checkdigit[c] == weighted_modulus_scheme::skip;
+      checkdigit_contributions[c] = contribution(checkdigit[c], checkdigit_weight, modulus);
+    }
+  }
+
+  bool check(const char *data, size_t n) const
+  {
+    size_t pos = 0, row = 0, checksum = 0;
+    bool ok = true;
+    if(forward)
+    {
+      for(size_t i = 0; i < n && ok; ++i)
+        ok = accumulate(static_cast<unsigned char>(data[i]), pos, row, checksum);
+    }
+    else
+    {
+      for(size_t i = n; i-- > 0 && ok;)
+        ok = accumulate(static_cast<unsigned char>(data[i]), pos, row, checksum);
+    }
+    return ok && pos > 0 && (size == 0 || pos == size) && checksum % modulus == remainder;
+  }
+
+  using detail::batch_validator<table_validator>::check;
+};
+
+/*! \class iban_validator
+    \brief The validation of an International Bank Account Number (ISO 13616).
+
+    The four first characters are moved to the end, the letters are replaced by two digits (A = 10... Z = 35) and the
+    number obtained modulo 97 must be 1. The spaces are skipped and the lower case letters are accepted.
+*/
+class iban_validator : public detail::batch_validator<iban_validator>
+{
+  static bool accumulate(char c, size_t &remainder)
+  {
+    if(c >= '0' && c <= '9')
+      remainder = (remainder * 10 + (c - '0')) % 97;
+    else if(c >= 'A' && c <= 'Z')
+      remainder = (remainder * 100 + (c - 'A' + 10)) % 97;
+    else
+      return false;
+    return true;
+  }
+
+public:
+  bool check(const char *data, size_t n) const
+  {
+    char iban[IBAN_MAX_SIZE];
+    size_t size = 0;
+    for(size_t i = 0; i < n; ++i)
+    {
+      char c = data[i];
+      if(c == ' ')
+        continue;
+      if(size == IBAN_MAX_SIZE)
+        return false;
+      iban[size++] = c >= 'a' && c <= 'z' ? static_cast<char>(c - 'a' + 'A') : c;
+    }
+    if(size < IBAN_MIN_SIZE || iban[0] < 'A' || iban[0] > 'Z' || iban[1] < 'A' || iban[1] > 'Z' ||
+       iban[2] < '0' || iban[2] > '9' || iban[3] < '0' || iban[3] > '9')
+      return false;
+
+    size_t remainder = 0;
+    for(size_t i = 4; i < size + 4; ++i)
+      if(!accumulate(iban[i % size], remainder))
+        return false;
+    return remainder == 1;
+  }
+
+  using detail::batch_validator<iban_validator>::check;
+};
+
+/*!
+  \brief The vehicle identification number (ISO 3779, North America): the letters are transliterated, the weights
+  go from 8 to 2 from the first character and the check digit at the ninth position is the checksum modulo 11, 'X' for 10.
+  The weight 10 of the check digit is -1 modulo 11, so a valid number has a null checksum.
+*/
+inline weighted_modulus_scheme vin_scheme()
+{
+  static const size_t weights[VIN_SIZE] = { 8, 7, 6, 5, 4, 3, 2, 10, 10, 9, 8, 7, 6, 5, 4, 3, 2 };
+  static const char letters[] = "ABCDEFGHJKLMNPRSTUVWXYZ";
+  static const int values[] = { 1, 2, 3, 4, 5, 6, 7, 8, 1, 2, 3, 4, 5, 7, 9, 2, 3, 4, 5, 6, 7, 8, 9 };
+
+  weighted_modulus_scheme vin;
+  vin.weights.assign(weights, weights + VIN_SIZE);
+  vin.modulus = 11;
+  vin.size = VIN_SIZE;
+  vin.forward = true;
+  for(size_t i = 0; letters[i] != '\0'; ++i)
+  {
+    vin.transliteration[static_cast<unsigned char>(letters[i])] = values[i];
+    vin.transliteration[static_cast<unsigned char>(letters[i] - 'A' + 'a')] = values[i];
+  }
+  vin.transliteration['I'] = vin.transliteration['O'] = vin.transliteration['Q'] = weighted_modulus_scheme::invalid;
+  vin.transliteration['i'] = vin.transliteration['o'] = vin.transliteration['q'] = weighted_modulus_scheme::invalid;
+  vin.checkdigit_pos = 8;
+  vin.checkdigit_transliteration = vin.transliteration;
+  for(int c = 'A'; c <= 'Z'; ++c)
+    vin.checkdigit_transliteration[c] = vin.checkdigit_transliteration[c - 'A' + 'a'] = weighted_modulus_scheme::invalid;
+  vin.checkdigit_transliteration['X'] = vin.checkdigit_transliteration['x'] = 10;
+  return vin;
+}
+
+/*! \class scheme_registry
+    \brief Map the names of the schemes to their validation.
+*/
+class scheme_registry
+{
+  std::map<std::string, boost::shared_ptr<const scheme_validator> > validators;
+
+public:
+  //! Register a validator, replacing the one of the same name.
+  void add(const std::string &name, const boost::shared_ptr<const scheme_validator> &validator)
+  {
+    validators[name] = validator;
+  }
+
+  //! Register a features type and its precheck.
+  template <typename Features, typename Precheck>
+  void add(const std::string &name)
+  {
+    add(name, boost::shared_ptr<const scheme_validator>(new features_validator<Features, Precheck>()));
+  }
+
+  //! Compile and register a scheme defined at runtime.
+  void add(const std::string &name, const weighted_modulus_scheme &scheme)
+  {
+    add(name, boost::shared_ptr<const scheme_validator>(new table_validator(scheme)));
+  }
+
+  /*!
+    \brief Find a scheme.
+
+    \returns The validator of the scheme, 0 if no scheme has this name.
+  */
+  const scheme_validator *find(const std::string &name) const
+  {
+    std::map<std::string, boost::shared_ptr<const scheme_validator> >::const_iterator it = validators.find(name);
+    return it == validators.end() ? 0 : it->second.get();
+  }
+};
+
+/*!
+    \brief Make a registry of the schemes of the library: "luhn", "visa", "mastercard", "amex", "ean8", "ean13", "upca",
+    "isbn10", "isbn13", "gtin14", "verhoeff", "iban" and "vin".
+*/
+inline scheme_registry make_builtin_registry()
+{
+  scheme_registry registry;
+  registry.add<features<luhn>, digit>("luhn");
+  registry.add<visa, digit>("visa");
+  registry.add<mastercard, digit>("mastercard");
+  registry.add<amex, digit>("amex");
+  registry.add<ean8, digit>("ean8");
+  registry.add<ean13, digit>("ean13");
+  registry.add<upca, digit>("upca");
+  registry.add<isbn10, digitx>("isbn10");
+  registry.add<isbn13, digit>("isbn13");
+  registry.add<gtin14, digit>("gtin14");
+  registry.add<features<verhoeff>, digit>("verhoeff");
+  registry.add("iban", boost::shared_ptr<const scheme_validator>(new iban_validator()));
+  registry.add("vin", vin_scheme());
+  return registry;
+}
+
+}} // namespace boost   namespace checkdigit
+#endif // BOOST_CHECKDIGIT_SCHEME_REGISTRY_HPP
@@ -36,7 +36,7 @@ struct size_failure_exception_policy
 {
   static void fail()
   {
-    throw FailureException;
+    throw FailureException();
   }
 };
 
@@ -0,0 +1,203 @@
+//  Boost checks/sliding_window.hpp header file
+//  (C) Copyright Pierre Talbot 2013
+//  Distributed under the Boost Software License, Version 1.0. (See
+//  accompanying file LICENSE_1_0.txt or copy at
+//  http://www.boost.org/LICENSE_1_0.txt)
+//  See http://www.boost.org for updates, documentation, and revision history.
+
+/*! \file
+    \brief Find the windows of a long digit string whose check digit is correct.
+
+    \details The processor of the features type must only depend on the parity of the position,
+    as luhn_processor and weighted_sum<weight<a, b> > (Luhn, EAN, UPC...). The contribution of each digit
+    at an even and at an odd position is computed once with the processor, and the checksum of a window is
+    kept up to date in constant time when the window shifts: the digit entering is added and the digit leaving
+    is removed from two sums, one per parity of the window end.
+*/
+
+#ifndef BOOST_CHECKDIGIT_SLIDING_WINDOW_HPP
+#define BOOST_CHECKDIGIT_SLIDING_WINDOW_HPP
+
+#ifdef _MSC_VER
+    #pragma once
+#endif
+
+#include <cstddef> // size_t
+#include <vector>
+#include <boost/static_assert.hpp>
+#include <boost/type_traits/integral_constant.hpp>
+
+#include <boost/checkdigit/basic_checks.hpp>
+#include <boost/checkdigit/weight.hpp>
+#include <boost/checkdigit/weighted_sum.hpp>
+#include <boost/checkdigit/luhn.hpp>
+
+namespace boost {
+    namespace checkdigit{
+
+/*!
+  \brief A window found by find_windows.
+*/
+struct window_match
+{
+  //! The offset of the first digit of the window.
+  size_t offset;
+  //! The number of digits of the window.
+  size_t width;
+};
+
+namespace detail
+{
+
+/*!
+  \brief @c true if the contribution of a value computed by Processor only depends on the parity of its position.
+*/
+template <typename Processor>
+struct parity_processor : boost::false_type
+{};
+
+template <>
+struct parity_processor<luhn_processor> : boost::true_type
+{};
+
+template <BOOST_PP_ENUM_PARAMS(BOOST_CHECKDIGIT_LIMIT_WEIGHTS, size_t weight_value)>
+struct parity_processor<weighted_sum<weight<BOOST_PP_ENUM_PARAMS(BOOST_CHECKDIGIT_LIMIT_WEIGHTS, weight_value)> > >
+  : boost::integral_constant<bool, weight<BOOST_PP_ENUM_PARAMS(BOOST_CHECKDIGIT_LIMIT_WEIGHTS, weight_value)>::size <= 2>
+{};
+
+/*!
+  \brief The contributions of a digit to the checksum at an even and at an odd position, computed by the processor.
+*/
+template <typename Processor>
+struct parity_contribution
+{
+  BOOST_STATIC_ASSERT(parity_processor<Processor>::value);
+
+  size_t even;
+  size_t odd;
+
+  explicit parity_contribution(char c)
+  {
+    size_t value = static_cast<unsigned char>(c) - '0';
+    if(value > 9)
+      even = odd = 0;
+    else
+    {
+      Processor process;
+      even = process(0, value, 0);
+      odd = process(0, value, 1);
+    }
+  }
+};
+
+} // namespace detail
+
+/*!
+    \brief Find every window of a given width whose check digit is correct.
+
+    \tparam Features is the features type, its processor must only depend on the parity of the position.
+    \tparam OutputIterator must accept size_t values.
+    \param seq is the digit string, a window containing a character that is not a digit is never valid.
+    \param size is the size of seq.
+    \param width is the number of digits of the windows, check digit included.
+    \param out receives the offsets of the valid windows, in increasing order.
+
+    \returns The output iterator after the last offset written.
+*/
+template <typename Features, typename OutputIterator>
+OutputIterator find_windows(const char *seq, size_t size, size_t width, OutputIterator out)
+{
+  typedef detail::parity_contribution<typename Features::checksum::processor> contribution;
+  typename Features::checksum::validate_checkdigit validate;
+  if(width == 0 || width > size)
+    return out;
+
+  // sums[p] is the checksum of the window if the index of its last digit has the parity p:
+  // the digit at the index i is at an even position if i has the parity p.
+  size_t sums[2] = { 0, 0 };
+  size_t next_digit = 0; // The index following the last character which is not a digit.
+  for(size_t i = 0; i < size; ++i)
+  {
+    contribution entering(seq[i]);
+    if(static_cast<unsigned char>(seq[i] - '0') > 9)
+      next_digit = i + 1;
+    sums[i & 1] += entering.even;
+    sums[~i & 1] += entering.odd;
+    if(i + 1 < width)
+      continue;
+
+    size_t first = i + 1 - width;
+    if(first >= next_digit && validate(sums[i & 1]))
+      *out++ = first;
+
+    contribution leaving(seq[first]);
+    sums[first & 1] -= leaving.even;
+    sums[~first & 1] -= leaving.odd;
+  }
+  return out;
+}
+
+/*!
+    \brief Find every window whose check digit is correct, for several widths in a single pass.
+
+    \tparam Features is the features type, its processor must only depend on the parity of the position.
+    \tparam OutputIterator must accept window_match values.
+    \param seq is the digit string.
+    \param size is the size of seq.
+    \param widths are the widths of the windows.
+    \param width_count is the number of widths.
+    \param out receives the valid windows ordered by end and, for the same end, in the order of widths.
+
+    \remarks The contributions are accumulated once into two prefix sums, then the checksum of any window is a difference
+    of two prefix sums. Only the last max(widths) + 1 prefix sums are kept, in ring buffers. The loop on the widths has
+    no dependency between iterations, so the compiler can vectorize it.
+*/
+template <typename Features, typename OutputIterator>
+OutputIterator find_windows(const char *seq, size_t size, const size_t *widths, size_t width_count, OutputIterator out)
+{
+  typedef detail::parity_contribution<typename Features::checksum::processor> contribution;
+  typename Features::checksum::validate_checkdigit validate;
+
+  size_t max_width = 0;
+  for(size_t w = 0; w < width_count; ++w)
+    max_width = widths[w] > max_width ? widths[w] : max_width;
+  const size_t ring = (max_width < size ? max_width : size) + 1;
+
+  // prefix[p][i % ring] is the checksum of seq[0..i) with the characters at an index of parity p at an even position;
+  // last_bad is the index following the last character which is not a digit in seq[0..end).
+  std::vector<size_t> prefix[2];
+  prefix[0].resize(ring);
+  prefix[1].resize(ring);
+  size_t last_bad = 0;
+  std::vector<char> valid(width_count);
+  for(size_t end = 1, head = 1 % ring; end <= size; ++end, head = head + 1 == ring ? 0 : head + 1)
+  {
+    size_t i = end - 1;
+    size_t previous = head == 0 ? ring - 1 : head - 1;
+    contribution c(seq[i]);
+    prefix[i & 1][head] = prefix[i & 1][previous] + c.even;
+    prefix[~i & 1][head] = prefix[~i & 1][previous] + c.odd;
+    if(static_cast<unsigned char>(seq[i] - '0') > 9)
+      last_bad = end;
+
+    const size_t *sums = &prefix[i & 1][0];
+    for(size_t w = 0; w < width_count; ++w)
+    {
+      size_t first = end - widths[w];
+      size_t slot = head >= widths[w] ? head - widths[w] : head + ring - widths[w];
+      valid[w] = widths[w] != 0 && widths[w] <= end && first >= last_bad && validate(sums[head] - sums[slot]);
+    }
+    for(size_t w = 0; w < width_count; ++w)
+    {
+      if(valid[w])
+      {
+        window_match match = { end - widths[w], widths[w] };
+        *out++ = match;
+      }
+    }
+  }
+  return out;
+}
+
+}} // namespace boost   namespace checkdigit
+#endif // BOOST_CHECKDIGIT_SLIDING_WINDOW_HPP
@@ -17,6 +17,7 @@
 #endif
 
 #include <cstddef> // size_t
+#include <string>
 #include <functional>
 #include <exception>
 
@@ -34,7 +35,9 @@ public:
 
   transliteration_exception(){}
 
-  virtual const char* what() const
+  virtual ~transliteration_exception() throw() {}
+
+  virtual const char* what() const throw()
   {
     return message.c_str();
   }
@@ -25,6 +25,7 @@
 #include <boost/checkdigit/basic_checks.hpp>
 #include <boost/checkdigit/modulus10.hpp>
 #include <boost/checkdigit/weighted_sum.hpp>
+#include <boost/checkdigit/precheck.hpp>
 
 /*!
   \brief This macro defines the size of an UPC-A.
@@ -40,6 +40,9 @@ namespace boost{
 template <BOOST_PP_ENUM_BINARY_PARAMS(BOOST_CHECKDIGIT_LIMIT_WEIGHTS, size_t weight_value, = 0 BOOST_PP_INTERCEPT) >
 struct weight
 {
+  //! The number of weights before the sequence repeats.
+  static const size_t size = 1;
+
 /*! \fn static int at(size_t value_pos)
     \brief Get the weight at the current value position.
 
@@ -53,6 +56,8 @@ struct weight
   template<BOOST_PP_ENUM_PARAMS(weight_size , size_t weight_value)> \
   struct weight<BOOST_PP_ENUM_PARAMS(weight_size, weight_value)> \
   { \
+    static const size_t size = weight_size; \
+ \
     static size_t at(size_t value_pos) \
     { \
       static const size_t weights[weight_size] = { BOOST_PP_ENUM_PARAMS(weight_size, weight_value) } ; \
@@ -27,16 +27,48 @@
 #include <boost/checkdigit/luhn.hpp>
 #include <boost/checkdigit/verhoeff.hpp>
 #include <boost/checkdigit/modulus11.hpp>
-#include <boost/checkdigit/modulus97.hpp>
+#include <boost/checkdigit/modulus97_10.hpp>
 #include <boost/checkdigit/ean.hpp>
 #include <boost/checkdigit/isbn.hpp>
 #include <boost/checkdigit/upc.hpp>
 #include <boost/checkdigit/amex.hpp>
 #include <boost/checkdigit/visa.hpp>
 #include <boost/checkdigit/mastercard.hpp>
+#include <boost/checkdigit/gs1.hpp>
+#include <boost/checkdigit/gtin.hpp>
+#include <boost/checkdigit/isbn_conversion.hpp>
+#include <boost/checkdigit/iso6346.hpp>
+#include <boost/checkdigit/barcode.hpp>
+#include <boost/checkdigit/parallel.hpp>
+#include <boost/checkdigit/pan_scanner.hpp>
+#include <boost/checkdigit/sliding_window.hpp>
+#include <boost/checkdigit/scatter_gather.hpp>
+#include <boost/checkdigit/partial_checksum.hpp>
+#include <boost/checkdigit/checked_id.hpp>
+#include <boost/checkdigit/correction.hpp>
+#include <boost/checkdigit/ocr_repair.hpp>
+#include <boost/checkdigit/id_generator.hpp>
+#include <boost/checkdigit/id_allocator.hpp>
+#include <boost/checkdigit/complete_inplace.hpp>
+#include <boost/checkdigit/integer_input.hpp>
+#include <boost/checkdigit/mainframe.hpp>
+#include <boost/checkdigit/packed_key.hpp>
+#include <boost/checkdigit/columnar.hpp>
+#include <boost/checkdigit/batch_scheduler.hpp>
+#include <boost/checkdigit/scheme_detection.hpp>
+#include <boost/checkdigit/scheme_registry.hpp>
+#include <boost/checkdigit/kernel_planner.hpp>
 #include <boost/checkdigit/checks_fwd.hpp> // Forward declarations.
+#include <boost/scoped_array.hpp>
 
 #include <utility>
+#include <vector>
+#include <iterator>
+#include <cstdlib>
+#include <cstdio>
+#include <fstream>
+#include <algorithm>
+#include <thread>
 
 #include "alteration_test.hpp"
 #include "transposition_test.hpp"
@@ -84,7 +116,7 @@ BOOST_AUTO_TEST_CASE(visa_tests)
 
   // Verify the check digit computation.
   BOOST_CHECK_EQUAL(compute_visa(visa_valid_without_checkdigit), valid_checkdigit);
-  BOOST_CHECKDIGIT_NE(compute_visa(visa_invalid_without_checkdigit), valid_checkdigit);
+  BOOST_CHECK_NE(compute_visa(visa_invalid_without_checkdigit), valid_checkdigit);
   BOOST_CHECK_EQUAL(compute_visa(visa_size_error), bad_sequence);
 }
 
@@ -116,7 +148,7 @@ BOOST_AUTO_TEST_CASE(amex_tests)
 
   // Verify the check digit computation.
   BOOST_CHECK_EQUAL(compute_amex(amex_valid_without_checkdigit), valid_checkdigit);
-  BOOST_CHECKDIGIT_NE(compute_amex(amex_invalid_without_checkdigit), valid_checkdigit);
+  BOOST_CHECK_NE(compute_amex(amex_invalid_without_checkdigit), valid_checkdigit);
   BOOST_CHECK_EQUAL(compute_amex(amex_size_error), bad_sequence);
 }
 
@@ -148,7 +180,7 @@ BOOST_AUTO_TEST_CASE(mastercard_tests)
 
   // Verify the check digit computation.
   BOOST_CHECK_EQUAL(compute_mastercard(mastercard_valid_without_checkdigit), valid_checkdigit);
-  BOOST_CHECKDIGIT_NE(compute_mastercard(mastercard_invalid_without_checkdigit), valid_checkdigit);
+  BOOST_CHECK_NE(compute_mastercard(mastercard_invalid_without_checkdigit), valid_checkdigit);
   BOOST_CHECK_EQUAL(compute_mastercard(mastercard_size_error), bad_sequence);
 }
 
@@ -180,7 +212,7 @@ BOOST_AUTO_TEST_CASE(ean13_tests)
 
   // Verify the check digit computation.
   BOOST_CHECK_EQUAL(compute_ean13(ean13_valid_without_checkdigit), valid_checkdigit);
-  BOOST_CHECKDIGIT_NE(compute_ean13(ean13_invalid_without_checkdigit), valid_checkdigit);
+  BOOST_CHECK_NE(compute_ean13(ean13_invalid_without_checkdigit), valid_checkdigit);
   BOOST_CHECK_EQUAL(compute_ean13(ean13_size_error), bad_sequence);
 }
 
@@ -213,7 +245,7 @@ BOOST_AUTO_TEST_CASE(ean8_tests)
 
   // Verify the check digit computation.
   BOOST_CHECK_EQUAL(compute_ean8(ean8_valid_without_checkdigit), valid_checkdigit);
-  BOOST_CHECKDIGIT_NE(compute_ean8(ean8_invalid_without_checkdigit), valid_checkdigit);
+  BOOST_CHECK_NE(compute_ean8(ean8_invalid_without_checkdigit), valid_checkdigit);
   BOOST_CHECK_EQUAL(compute_ean8(ean8_size_error), bad_sequence);
 }
 
@@ -248,7 +280,7 @@ BOOST_AUTO_TEST_CASE(upc_tests)
 
   // Verify the check digit computation.
   BOOST_CHECK_EQUAL(compute_upca(upca_valid_without_checkdigit), valid_checkdigit);
-  BOOST_CHECKDIGIT_NE(compute_upca(upca_invalid_without_checkdigit), valid_checkdigit);
+  BOOST_CHECK_NE(compute_upca(upca_invalid_without_checkdigit), valid_checkdigit);
   BOOST_CHECK_EQUAL(compute_upca(upca_size_error), bad_sequence);
 }
 
@@ -284,7 +316,7 @@ BOOST_AUTO_TEST_CASE(isbn13_tests)
 
   // Verify the check digit computation.
   BOOST_CHECK_EQUAL(compute_isbn13(isbn13_valid_without_checkdigit), valid_checkdigit);
-  BOOST_CHECKDIGIT_NE(compute_isbn13(isbn13_not_valid_without_checkdigit), valid_checkdigit);
+  BOOST_CHECK_NE(compute_isbn13(isbn13_not_valid_without_checkdigit), valid_checkdigit);
   BOOST_CHECK_EQUAL(compute_isbn13(isbn13_size_error), bad_sequence);
 }
 
@@ -319,7 +351,7 @@ BOOST_AUTO_TEST_CASE(isbn10_tests)
 
   // Verify the check digit computation.
   BOOST_CHECK_EQUAL(compute_isbn10(isbn10_valid_without_checkdigit), valid_checkdigit);
-  BOOST_CHECKDIGIT_NE(compute_isbn10(isbn10_invalid_without_checkdigit), valid_checkdigit);
+  BOOST_CHECK_NE(compute_isbn10(isbn10_invalid_without_checkdigit), valid_checkdigit);
   BOOST_CHECK_EQUAL(compute_isbn10(isbn10_size_error), bad_sequence);
 }
 
@@ -356,10 +388,258 @@ BOOST_AUTO_TEST_CASE(mod97_10_tests)
 
   // Verify the check digit computation.
   BOOST_CHECK_EQUAL(compute_mod97_10(mod97_10_valid_without_checkdigits), checkdigits);
-  BOOST_CHECKDIGIT_NE(compute_mod97_10(mod97_10_invalid_without_checkdigits), checkdigits);
+  BOOST_CHECK_NE(compute_mod97_10(mod97_10_invalid_without_checkdigits), checkdigits);
   BOOST_CHECK_EQUAL(compute_mod97_10<16>(mod97_10_size_error), bad_sequence);
 }
 
+BOOST_AUTO_TEST_CASE(gs1_tests)
+{
+  // Checkdigit validation tests.
+  BOOST_CHECK(check_gtin14(std::string("1 0614141 00041 5")));
+  BOOST_CHECK(check_sscc(std::string("1 0614141 234567890 8")));
+  BOOST_CHECK(check_gln(std::string("061414100001 2")));
+  BOOST_CHECK(check_gsin(std::string("0614141 123456789 0")));
+  BOOST_CHECK_EQUAL(check_gtin14(std::string("1 0614141 00041 6")), false);
+  BOOST_CHECK_EQUAL(check_gtin14(std::string("0614141 00041 5")), false);
+
+  // Checkdigit computation tests.
+  BOOST_CHECK_EQUAL(compute_gtin14(std::string("1 0614141 00041")), 5u);
+  BOOST_CHECK_EQUAL(compute_sscc(std::string("1 0614141 234567890")), 8u);
+  BOOST_CHECK_EQUAL(compute_gln(std::string("061414100001")), 2u);
+  BOOST_CHECK_EQUAL(compute_gsin(std::string("0614141 123456789")), 0u);
+  BOOST_CHECK_EQUAL(compute_gsin(std::string("0614141 12345678")), bad_sequence);
+
+  // Element strings: fixed size AIs, variable size AIs terminated by FNC1, symbology identifier.
+  std::string fnc1(1, GS1_FNC1);
+  std::string payload = "]C1" "0110614141000415" "10ABC123" + fnc1 + "17261231" "00106141412345678908" "4100614141000012";
+  std::vector<gs1_element> elements;
+  BOOST_CHECK(parse_gs1_element_string(payload.data(), payload.data() + payload.size(), std::back_inserter(elements)) == payload.data() + payload.size());
+  BOOST_REQUIRE_EQUAL(elements.size(), 5u);
+  BOOST_CHECK_EQUAL(std::string(elements[0].ai->prefix), "01");
+  BOOST_CHECK_EQUAL(std::string(elements[1].data, elements[1].data_size), "ABC123");
+  BOOST_CHECK_EQUAL(elements[4].ai->ai_size, 3);
+  BOOST_CHECK(check_gs1_element_string(payload));
+
+  // A wrong key, a missing FNC1 and an unknown AI.
+  BOOST_CHECK_EQUAL(check_gs1_element_string("0110614141000416"), false);
+  BOOST_CHECK_EQUAL(check_gs1_element_string("10ABC12317261231"), true);
+  BOOST_CHECK_EQUAL(check_gs1_element_string("10ABC123456789012345678" + fnc1 + "17261231"), false);
+  BOOST_CHECK_EQUAL(check_gs1_element_string("05123"), false);
+}
+
+BOOST_AUTO_TEST_CASE(gtin_normalization_tests)
+{
+  char gtin[GTIN14_SIZE];
+
+  // UPC-E expansion, one per rule on the last digit.
+  BOOST_CHECK(upce_to_gtin14("01234565", gtin));
+  BOOST_CHECK_EQUAL(std::string(gtin, GTIN14_SIZE), "00012345000065");
+  char upca[UPCA_SIZE];
+  BOOST_CHECK(upce_to_upca("04252614", upca));
+  BOOST_CHECK_EQUAL(std::string(upca, UPCA_SIZE), "042100005264");
+  BOOST_CHECK(upce_to_upca("01234531", upca) == check_upca(std::string("012300000451")));
+  BOOST_CHECK_EQUAL(std::string(upca, UPCA_SIZE), "012300000451");
+  BOOST_CHECK_EQUAL(upce_to_gtin14("01234566", gtin), false);
+  BOOST_CHECK_EQUAL(upce_to_gtin14("21234565", gtin), false);
+
+  // Padding of EAN-8, UPC-A and EAN-13, the check digit is carried.
+  BOOST_CHECK(normalize_gtin14("96385074", 8, gtin));
+  BOOST_CHECK_EQUAL(std::string(gtin, GTIN14_SIZE), "00000096385074");
+  BOOST_CHECK(normalize_gtin14("036000291452", 12, gtin));
+  BOOST_CHECK(check_gtin14(std::string(gtin, GTIN14_SIZE)));
+  BOOST_CHECK(normalize_gtin14("4006381333931", 13, gtin));
+  BOOST_CHECK_EQUAL(std::string(gtin, GTIN14_SIZE), "04006381333931");
+  BOOST_CHECK_EQUAL(normalize_gtin14("4006381333932", 13, gtin), false);
+  BOOST_CHECK_EQUAL(normalize_gtin14("400638133393", 11, gtin), false);
+
+  // Batches.
+  const char *seqs[] = { "96385074", "036000291452", "4006381333932", "10614141000415" };
+  size_t sizes[] = { 8, 12, 13, 14 };
+  char gtins[4 * GTIN14_SIZE];
+  bool valid[4];
+  BOOST_CHECK_EQUAL(normalize_gtin14(seqs, sizes, 4, gtins, valid), 3u);
+  BOOST_CHECK(valid[0] && valid[1] && !valid[2] && valid[3]);
+  BOOST_CHECK_EQUAL(std::string(gtins + 3 * GTIN14_SIZE, GTIN14_SIZE), "10614141000415");
+
+  const char upces[] = "01234565" "04252614";
+  BOOST_CHECK_EQUAL(upce_to_gtin14(upces, UPCE_SIZE, 2, gtins, valid), 2u);
+  BOOST_CHECK_EQUAL(std::string(gtins + GTIN14_SIZE, GTIN14_SIZE), "00042100005264");
+}
+
+BOOST_AUTO_TEST_CASE(isbn_conversion_tests)
+{
+  char isbn13[EAN13_SIZE];
+  char isbn10[ISBN10_SIZE];
+
+  std::string isbn10_valid = "0-306-40615-2";
+  BOOST_CHECK(isbn10_to_isbn13(isbn10_valid.begin(), isbn10_valid.end(), isbn13));
+  BOOST_CHECK_EQUAL(std::string(isbn13, EAN13_SIZE), "9780306406157");
+  BOOST_CHECK(check_isbn13(std::string(isbn13, EAN13_SIZE)));
+
+  std::string isbn10_x = "0-8044-2957-X";
+  BOOST_CHECK(isbn10_to_isbn13(isbn10_x.begin(), isbn10_x.end(), isbn13));
+  BOOST_CHECK_EQUAL(std::string(isbn13, EAN13_SIZE), "9780804429573");
+  BOOST_CHECK(isbn13_to_isbn10(isbn13, isbn13 + EAN13_SIZE, isbn10));
+  BOOST_CHECK_EQUAL(std::string(isbn10, ISBN10_SIZE), "080442957X");
+
+  std::string isbn13_valid = "978-0-306-40615-7";
+  BOOST_CHECK(isbn13_to_isbn10(isbn13_valid.begin(), isbn13_valid.end(), isbn10));
+  BOOST_CHECK_EQUAL(std::string(isbn10, ISBN10_SIZE), "0306406152");
+
+  // Invalid sources: check digit, size, 'X' misplaced, prefix 979.
+  std::string failures[] = { "0-306-40615-3", "0-306-40615", "0-306-4061X-2" };
+  for(size_t i = 0; i < 3; ++i)
+    BOOST_CHECK_EQUAL(isbn10_to_isbn13(failures[i].begin(), failures[i].end(), isbn13), false);
+  std::string isbn13_979 = "979-10-90636-07-1";
+  BOOST_CHECK(check_isbn13(isbn13_979));
+  BOOST_CHECK_EQUAL(isbn13_to_isbn10(isbn13_979.begin(), isbn13_979.end(), isbn10), false);
+  BOOST_CHECK_EQUAL(isbn13_to_isbn10(isbn13_valid.begin(), isbn13_valid.end() - 1, isbn10), false);
+
+  // Batches.
+  const char *seqs[] = { "0306406152", "080442957X", "0306406153" };
+  size_t sizes[] = { 10, 10, 10 };
+  char isbn13s[3 * EAN13_SIZE];
+  bool valid[3];
+  BOOST_CHECK_EQUAL(isbn10_to_isbn13(seqs, sizes, 3, isbn13s, valid), 2u);
+  BOOST_CHECK(valid[0] && valid[1] && !valid[2]);
+  BOOST_CHECK_EQUAL(std::string(isbn13s + EAN13_SIZE, EAN13_SIZE), "9780804429573");
+
+  const char *seqs13[] = { isbn13s, isbn13s + EAN13_SIZE };
+  size_t sizes13[] = { EAN13_SIZE, EAN13_SIZE };
+  char isbn10s[2 * ISBN10_SIZE];
+  BOOST_CHECK_EQUAL(isbn13_to_isbn10(seqs13, sizes13, 2, isbn10s, valid), 2u);
+  BOOST_CHECK_EQUAL(std::string(isbn10s, 2 * ISBN10_SIZE), "0306406152080442957X");
+}
+
+BOOST_AUTO_TEST_CASE(iso6346_tests)
+{
+  // Letter values, skipping the multiples of 11.
+  iso6346_transliteration transliteration;
+  BOOST_CHECK_EQUAL(transliteration('A'), 10u);
+  BOOST_CHECK_EQUAL(transliteration('B'), 12u);
+  BOOST_CHECK_EQUAL(transliteration('L'), 23u);
+  BOOST_CHECK_EQUAL(transliteration('V'), 34u);
+  BOOST_CHECK_EQUAL(transliteration('Z'), 38u);
+
+  // Checkdigit validation tests.
+  BOOST_CHECK(check_iso6346(std::string("CSQU 305438 3")));
+  BOOST_CHECK(check_iso6346(std::string("MSKU9070323")));
+  BOOST_CHECK_EQUAL(check_iso6346(std::string("CSQU 305438 4")), false);
+  BOOST_CHECK_EQUAL(check_iso6346(std::string("CSQU 30543 3")), false);
+
+  // Checkdigit computation tests.
+  BOOST_CHECK_EQUAL(compute_iso6346(std::string("CSQU 305438")), 3u);
+  BOOST_CHECK_EQUAL(compute_iso6346(std::string("TGHU 123456")), 7u);
+  BOOST_CHECK_EQUAL(compute_iso6346(std::string("TGHU 12345")), bad_sequence);
+
+  // Batch of fixed size records.
+  const char records[] = "CSQU3054383|MSKU9070324|TGHU1234567|CSQ03054383|";
+  bool valid[4];
+  BOOST_CHECK_EQUAL(check_iso6346(records, ISO6346_SIZE + 1, 4, valid), 2u);
+  BOOST_CHECK(valid[0] && !valid[1] && valid[2] && !valid[3]);
+
+  // A letter in the serial number with the weighted sum of a valid code: both paths reject it.
+  const char malformed[] = "CSQUD054383";
+  BOOST_CHECK_EQUAL(check_iso6346(malformed, ISO6346_SIZE, 1, valid), 0u);
+  BOOST_CHECK_EQUAL(check_iso6346(std::string(malformed)), valid[0]);
+  BOOST_CHECK_EQUAL(check_iso6346(std::string("3SQU3054383")), false);
+  BOOST_CHECK_EQUAL(compute_iso6346(std::string("CSQUD05438")), bad_sequence);
+}
+
+BOOST_AUTO_TEST_CASE(barcode_tests)
+{
+  // Code 128, code set B.
+  BOOST_CHECK_EQUAL(compute_code128b("Wikipedia"), 88u);
+  BOOST_CHECK(check_code128b("Wikipedia", 88));
+  BOOST_CHECK_EQUAL(check_code128b("Wikipedai", 88), false);
+  BOOST_CHECK_EQUAL(compute_code128b(std::string("caf\xe9")), bad_sequence);
+
+  // Code 39 modulus 43.
+  BOOST_CHECK_EQUAL(compute_code39("WIKIPEDIA"), '$');
+  BOOST_CHECK_EQUAL(compute_code39("A-1 $"), ' ');
+  BOOST_CHECK(check_code39("CODE39W"));
+  BOOST_CHECK_EQUAL(check_code39("CODE93W"), true); // Code 39 mod 43 doesn't catch transpositions.
+  BOOST_CHECK_EQUAL(check_code39("CODE39 "), false);
+  BOOST_CHECK_EQUAL(check_code39("code39W"), false);
+  BOOST_CHECK_EQUAL(compute_code39("code39"), bad_sequence);
+  std::string code39 = "CODE39W";
+  BOOST_CHECK(check_code39(code39.begin(), code39.end()));
+  BOOST_CHECK_EQUAL(check_code39(code39.begin(), code39.begin()), false);
+}
+
+BOOST_AUTO_TEST_CASE(pan_scanner_tests)
+{
+  std::string text = "Card 4417 1234 5678 9113, exp 12/25.\n"
+                     "Amex: 3782-822463-10005; wrong 4417123456789112; mc 5105105105105100\n"
+                     "too long 44171234567891130000, two spaces 4417  1234 5678 9113, ends 5105 1051 0510 5100";
+  size_t visa_offset = text.find("4417 1234");
+  size_t amex_offset = text.find("3782");
+  size_t mastercard_offset = text.find("5105105105105100");
+  size_t last_offset = text.find("5105 1051");
+
+  std::vector<pan_match> matches;
+  scan_pan(text.data(), text.size(), std::back_inserter(matches));
+  BOOST_REQUIRE_EQUAL(matches.size(), 4u);
+  BOOST_CHECK_EQUAL(matches[0].offset, visa_offset);
+  BOOST_CHECK_EQUAL(matches[0].size, 19u);
+  BOOST_CHECK_EQUAL(matches[0].brand, visa_pan);
+  BOOST_CHECK_EQUAL(matches[1].offset, amex_offset);
+  BOOST_CHECK_EQUAL(matches[1].size, 17u);
+  BOOST_CHECK_EQUAL(matches[1].brand, amex_pan);
+  BOOST_CHECK_EQUAL(matches[2].offset, mastercard_offset);
+  BOOST_CHECK_EQUAL(matches[2].size, 16u);
+  BOOST_CHECK_EQUAL(matches[2].brand, mastercard_pan);
+  BOOST_CHECK_EQUAL(matches[3].offset, last_offset);
+
+  // The same matches are found when the text is split in two chunks anywhere.
+  for(size_t cut = 0; cut <= text.size(); ++cut)
+  {
+    std::vector<pan_match> chunked;
+    pan_scanner scanner;
+    scanner.scan(text.data(), cut, std::back_inserter(chunked));
+    scanner.scan(text.data() + cut, text.size() - cut, std::back_inserter(chunked));
+    scanner.finish(std::back_inserter(chunked));
+    BOOST_REQUIRE_EQUAL(chunked.size(), matches.size());
+    for(size_t i = 0; i < matches.size(); ++i)
+      BOOST_CHECK_EQUAL(chunked[i].offset, matches[i].offset);
+  }
+}
+
+template <typename Features, typename Confusion, typename Precheck>
+void check_ocr_repair(const std::string &x, const std::string &expected, size_t expected_cost, size_t max_cost = BOOST_CHECKDIGIT_OCR_MAX_COST)
+{
+  std::vector<ocr_candidate> candidates;
+  repair_ocr<Features, Confusion>(x, std::back_inserter(candidates), max_cost);
+  BOOST_REQUIRE(!candidates.empty());
+  BOOST_CHECK_EQUAL(candidates[0].sequence, expected);
+  BOOST_CHECK_EQUAL(candidates[0].cost, expected_cost);
+  for(size_t i = 0; i < candidates.size(); ++i)
+  {
+    BOOST_CHECK(check_sequence<Features>(make_precheck<Precheck>(candidates[i].sequence)));
+    BOOST_CHECK(i == 0 || candidates[i - 1].cost <= candidates[i].cost);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(ocr_repair_tests)
+{
+  check_ocr_repair<ean13, ocr_digit, digit>("5 9O1234 l23457", "5901234123457", 2);
+  check_ocr_repair<ean13, ocr_digit, digit>("5 901234 1Z3457", "5901234123457", 1);
+  check_ocr_repair<visa, ocr_digit, digit>("4417 l234 S678 9ll3", "4417123456789113", 4, 4);
+  check_ocr_repair<visa, ocr_digit, digit>("4417 1234 567B 9113", "4417123456789113", 1);
+  check_ocr_repair<isbn10, ocr_digitx, digitx>("0-201-7OO73-5", "0201700735", 2);
+  check_ocr_repair<isbn10, ocr_digitx, digitx>("O-8044-2957-x", "080442957X", 1);
+  // The last ambiguous character is solved from the partial state of the others.
+  check_ocr_repair<features<verhoeff>, ocr_digit, digit>("Z363", "2363", 1);
+  check_ocr_repair<features<verhoeff>, ocr_digit, digit>("2 363", "2363", 0);
+
+  // The cost bound cuts the readings.
+  std::vector<ocr_candidate> candidates;
+  repair_ocr<visa, ocr_digit>(std::string("4417 l234 S678 9ll3"), std::back_inserter(candidates));
+  BOOST_CHECK(candidates.empty());
+  repair_ocr<visa, ocr_digit>(std::string("4417 1234 5678 911"), std::back_inserter(candidates));
+  BOOST_CHECK(candidates.empty());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 BOOST_AUTO_TEST_SUITE(technical_tests)
@@ -391,31 +671,942 @@ struct modulus11_functor
   }
 };
 
+BOOST_AUTO_TEST_CASE(positional_weight_test)
+{
+  for(size_t i = 0; i < 100; ++i)
+  {
+    BOOST_CHECK_EQUAL(linear_weight<>::at(i), i + 1);
+    BOOST_CHECK_EQUAL((arithmetic_weight<3, 2>::at(i)), 3 + 2 * i);
+  }
+  BOOST_CHECK_EQUAL((geometric_weight<1, 2>::at(9)), 512u);
+
+  // The prefix sums and the running geometric weight give the same checksum as the weights at each position.
+  size_t values[] = { 4, 0, 7, 1, 9, 3, 3, 8, 2, 5, 6 };
+  size_t expected_linear = 0, expected_geometric = 0, geometric = 0;
+  weighted_sum<geometric_weight<1, 2> > geometric_processor;
+  for(size_t pos = 0; pos < 11; ++pos)
+  {
+    expected_linear += values[10 - pos] * (arithmetic_weight<3, 2>::at(pos));
+    expected_geometric += values[10 - pos] * (geometric_weight<1, 2>::at(pos));
+    geometric = geometric_processor(geometric, values[10 - pos], pos);
+  }
+  BOOST_CHECK_EQUAL((detail::arithmetic_weighted_sum<3, 2>(values, values + 11)), expected_linear);
+  BOOST_CHECK_EQUAL(geometric, expected_geometric);
+}
+
+BOOST_AUTO_TEST_CASE(parallel_test)
+{
+  std::vector<std::string> numbers;
+  for(size_t i = 0; i < 5000; ++i)
+  {
+    std::string number = boost::lexical_cast<std::string>(4417123456789000ull + i * 7);
+    numbers.push_back(number);
+  }
+
+  std::vector<bitmap_word> bitmap(bitmap_size(numbers.size()));
+  std::vector<size_t> checkdigits(numbers.size());
+  size_t valid = check_sequence<features<luhn>, digit>(numbers.begin(), numbers.end(), &bitmap[0], 3, 512);
+  compute_checkdigit<features<luhn>, digit>(numbers.begin(), numbers.end(), checkdigits.begin(), 3, 1000);
+
+  size_t expected_valid = 0;
+  for(size_t i = 0; i < numbers.size(); ++i)
+  {
+    bool expected = check_luhn(make_precheck<digit>(numbers[i]));
+    expected_valid += expected;
+    BOOST_CHECK_EQUAL(bitmap_test(&bitmap[0], i), expected);
+    BOOST_CHECK_EQUAL(checkdigits[i], compute_luhn(make_precheck<digit>(numbers[i])));
+  }
+  BOOST_CHECK_EQUAL(valid, expected_valid);
+
+  // The chunks follow the cache lines of a bitmap not aligned on 64 bytes.
+  std::vector<bitmap_word> shifted(bitmap_size(numbers.size()) + 3);
+  BOOST_CHECK_EQUAL((check_sequence<features<luhn>, digit>(numbers.begin(), numbers.end(), &shifted[3], 3, 512)), expected_valid);
+  BOOST_CHECK(std::equal(bitmap.begin(), bitmap.end(), shifted.begin() + 3));
+}
+
+BOOST_AUTO_TEST_CASE(sliding_window_test)
+{
+  std::string digits;
+  std::srand(7);
+  for(size_t i = 0; i < 300; ++i)
+    digits += static_cast<char>('0' + std::rand() % 10);
+  digits[150] = '-';
+
+  size_t widths[] = { 8, 13, 16 };
+  std::vector<window_match> luhn_matches, ean_matches;
+  find_windows<features<luhn> >(digits.data(), digits.size(), widths, 3, std::back_inserter(luhn_matches));
+  find_windows<features<ean> >(digits.data(), digits.size(), widths, 3, std::back_inserter(ean_matches));
+
+  // Every window is compared with the validation of the window alone.
+  size_t luhn_count = 0, ean_count = 0;
+  for(size_t w = 0; w < 3; ++w)
+  {
+    std::vector<size_t> luhn_offsets, ean_offsets;
+    find_windows<features<luhn> >(digits.data(), digits.size(), widths[w], std::back_inserter(luhn_offsets));
+    find_windows<features<ean> >(digits.data(), digits.size(), widths[w], std::back_inserter(ean_offsets));
+
+    std::vector<size_t> expected_luhn, expected_ean;
+    for(size_t first = 0; first + widths[w] <= digits.size(); ++first)
+    {
+      std::string window = digits.substr(first, widths[w]);
+      if(window.find('-') != std::string::npos)
+        continue;
+      if(check_sequence<features<luhn> >(make_precheck<digit>(window)))
+        expected_luhn.push_back(first);
+      if(check_sequence<features<ean> >(make_precheck<digit>(window)))
+        expected_ean.push_back(first);
+    }
+    BOOST_CHECK(luhn_offsets == expected_luhn);
+    BOOST_CHECK(ean_offsets == expected_ean);
+    luhn_count += expected_luhn.size();
+    ean_count += expected_ean.size();
+  }
+  BOOST_CHECK_EQUAL(luhn_matches.size(), luhn_count);
+  BOOST_CHECK_EQUAL(ean_matches.size(), ean_count);
+  for(size_t i = 0; i < luhn_matches.size(); ++i)
+  {
+    std::string window = digits.substr(luhn_matches[i].offset, luhn_matches[i].width);
+    BOOST_CHECK(check_sequence<features<luhn> >(make_precheck<digit>(window)));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(scatter_gather_test)
+{
+  std::string visa_number = "4417 1234 5678 9113";
+  std::string isbn = "0-201-70073-5";
+  std::string upc = "03600029145";
+
+  // Every split into three segments gives the result of the contiguous sequence.
+  for(size_t i = 0; i <= isbn.size(); ++i)
+  {
+    for(size_t j = i; j <= isbn.size(); ++j)
+    {
+      segment visa_segments[] = { { visa_number.data(), (std::min)(i, visa_number.size()) },
+                                  { visa_number.data() + (std::min)(i, visa_number.size()), (std::min)(j, visa_number.size()) - (std::min)(i, visa_number.size()) },
+                                  { visa_number.data() + (std::min)(j, visa_number.size()), visa_number.size() - (std::min)(j, visa_number.size()) } };
+      segment isbn_segments[] = { { isbn.data(), i }, { isbn.data() + i, j - i }, { isbn.data() + j, isbn.size() - j } };
+      size_t k = (std::min)(j, upc.size());
+      segment upc_segments[] = { { upc.data(), k }, { upc.data() + k, upc.size() - k } };
+
+      BOOST_CHECK((check_sequence<visa, digit>(visa_segments, 3)));
+      BOOST_CHECK((check_sequence<isbn10, digitx>(isbn_segments, 3)));
+      BOOST_CHECK_EQUAL((check_sequence<isbn13, digit>(isbn_segments, 3)), false);
+      BOOST_CHECK_EQUAL((compute_checkdigit<features<ean>, digit>(upc_segments, 2)), compute_upca(upc));
+    }
+  }
+  segment empty = { visa_number.data(), 0 };
+  BOOST_CHECK_EQUAL((check_sequence<visa, digit>(&empty, 1)), false);
+}
+
+template <typename Processor>
+void check_partial_checksum(const size_t *values, size_t size, size_t modulus)
+{
+  typedef partial_checksum<Processor> partial;
+  Processor process;
+  size_t expected = 0;
+  for(size_t pos = 0; pos < size; ++pos)
+    expected = process(expected, values[pos], pos);
+
+  // Three pieces combined in both groupings give the checksum of the whole sequence.
+  for(size_t i = 0; i <= size; i += 3)
+  {
+    for(size_t j = i; j <= size; j += 5)
+    {
+      typename partial::state a = make_partial_checksum<Processor>(values, values + i);
+      typename partial::state b = make_partial_checksum<Processor>(values + i, values + j);
+      typename partial::state c = make_partial_checksum<Processor>(values + j, values + size);
+      BOOST_CHECK_EQUAL(partial::checksum(partial::combine(partial::combine(a, b), c)) % modulus, expected % modulus);
+      BOOST_CHECK_EQUAL(partial::checksum(partial::combine(a, partial::combine(b, c))) % modulus, expected % modulus);
+    }
+  }
+  BOOST_CHECK_EQUAL(partial::checksum(partial::combine(partial::empty(), make_partial_checksum<Processor>(values, values + size))),
+                    partial::checksum(make_partial_checksum<Processor>(values, values + size)));
+}
+
+BOOST_AUTO_TEST_CASE(partial_checksum_test)
+{
+  size_t values[40];
+  std::srand(11);
+  for(size_t i = 0; i < 40; ++i)
+    values[i] = std::rand() % 10;
+
+  check_partial_checksum<luhn_processor>(values, 40, size_t(-1));
+  check_partial_checksum<verhoeff_processor>(values, 40, size_t(-1));
+  check_partial_checksum<ean_processor>(values, 40, size_t(-1));
+  check_partial_checksum<weighted_sum<mod11_weight> >(values, 40, size_t(-1));
+  check_partial_checksum<weighted_sum<linear_weight<1> > >(values, 40, size_t(-1));
+  check_partial_checksum<weighted_sum<geometric_weight<1, 2> > >(values, 40, size_t(-1));
+  check_partial_checksum<mod97_10_processor>(values, 40, 97);
+}
+
+template <typename Features, typename Precheck>
+void check_checked_id(std::string x)
+{
+  checked_id<Features, Precheck> id(x);
+  BOOST_CHECK_EQUAL(id.valid(), check_sequence<Features>(make_precheck<Precheck>(x)));
+
+  // Every replacement and swap gives the result of the validation of the modified sequence.
+  std::string digits;
+  for(size_t i = 0; i < x.size(); ++i)
+    if((x[i] >= '0' && x[i] <= '9') || x[i] == 'X')
+      digits += x[i];
+  for(size_t i = 0; i < digits.size(); ++i)
+  {
+    char original = digits[i];
+    for(char c = '0'; c <= '9'; ++c)
+    {
+      digits[i] = c;
+      id.replace(i, c - '0');
+      BOOST_CHECK_EQUAL(id.valid(), check_sequence<Features>(make_precheck<Precheck>(digits)));
+    }
+    digits[i] = original;
+    id.replace(i, original == 'X' ? 10 : original - '0');
+  }
+  for(size_t i = 0; i + 2 < digits.size(); ++i)
+  {
+    std::swap(digits[i], digits[i + 2]);
+    id.swap(i, i + 2);
+    BOOST_CHECK_EQUAL(id.valid(), check_sequence<Features>(make_precheck<Precheck>(digits)));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(checked_id_test)
+{
+  check_checked_id<visa, digit>("4417 1234 5678 9113");
+  check_checked_id<ean13, digit>("5 901234 123457");
+  check_checked_id<isbn10, digitx>("0-201-70073-5");
+  check_checked_id<features<verhoeff>, digit>("2363");
+  check_checked_id<features<verhoeff>, digit>("12345678902");
+
+  checked_id<visa> id(std::string("4417 1234 5678 9113"));
+  BOOST_CHECK(id.valid());
+  id.replace(15, 4);
+  BOOST_CHECK_EQUAL(id.valid(), false);
+  id.replace(15, 3);
+  BOOST_CHECK(id.valid());
+}
+
+template <typename Features, typename Precheck>
+void check_corrections(const std::string &x, const std::string &expected)
+{
+  std::vector<correction> corrections;
+  find_corrections<Features, Precheck>(x, std::back_inserter(corrections));
+
+  // Every correction makes the sequence valid, and one of them gives the expected sequence.
+  std::string digits;
+  for(size_t i = 0; i < x.size(); ++i)
+    if(typename Precheck::FilterPredicate()(x[i]) || x[i] == '?')
+      digits += x[i];
+  bool found = false;
+  for(size_t i = 0; i < corrections.size(); ++i)
+  {
+    std::string corrected = digits;
+    if(corrections[i].kind == jump_transposition || corrections[i].kind == adjacent_transposition)
+      std::swap(corrected[corrections[i].first], corrected[corrections[i].second]);
+    else
+    {
+      corrected[corrections[i].first] = corrections[i].first_value == 10 ? 'X' : '0' + corrections[i].first_value;
+      corrected[corrections[i].second] = corrections[i].second_value == 10 ? 'X' : '0' + corrections[i].second_value;
+    }
+    BOOST_CHECK(check_sequence<Features>(make_precheck<Precheck>(corrected)));
+    found |= corrected == expected;
+  }
+  BOOST_CHECK_MESSAGE(found, x << " was not corrected into " << expected);
+}
+
+BOOST_AUTO_TEST_CASE(correction_test)
+{
+  check_corrections<visa, digit>("4417 1234 5679 9113", "4417123456789113");   // Substitution.
+  check_corrections<visa, digit>("4417 1234 5687 9113", "4417123456789113");   // Adjacent transposition.
+  check_corrections<visa, digit>("4417 1234 5?78 9113", "4417123456789113");   // Erasure.
+  check_corrections<visa, digit>("4417 1234 5?78 91?3", "4417123456789113");   // Two erasures.
+  check_corrections<ean13, digit>("5 901234 132457", "5901234123457");
+  check_corrections<ean13, digit>("5 901234 123?57", "5901234123457");
+  check_corrections<isbn10, digitx>("0-201-70037-5", "0201700735");
+  check_corrections<isbn10, digitx>("0-201-07073-5", "0201700735");            // Jump transposition.
+  check_corrections<isbn10, digitx>("0-8044-2957-?", "080442957X");
+  check_corrections<features<verhoeff>, digit>("12345678920", "12345678902");
+  check_corrections<features<verhoeff>, digit>("1234567?902", "12345678902");
+
+  std::vector<correction> corrections;
+  find_corrections<visa, digit>(std::string("441 1234 5678 9113"), std::back_inserter(corrections));
+  BOOST_CHECK(corrections.empty());
+  find_corrections<visa, digit>(std::string("4417 1234 ??78 ?113"), std::back_inserter(corrections));
+  BOOST_CHECK(corrections.empty());
+
+  // Transposing the 'X' check digit into the payload would give a valid sum, but 'X' is not a payload value.
+  check_corrections<isbn10, digitx>("0-306-40613-X", "0306406136");
+  find_corrections<isbn10, digitx>(std::string("0-306-40613-X"), std::back_inserter(corrections));
+  for(size_t i = 0; i < corrections.size(); ++i)
+  {
+    BOOST_CHECK(corrections[i].first_value < 10 || corrections[i].first == 9);
+    BOOST_CHECK(corrections[i].second_value < 10 || corrections[i].second == 9);
+  }
+}
+
+template <typename Features, typename Precheck>
+void check_id_generator(const std::string &first, size_t count)
+{
+  id_generator<Features> generator(first);
+  size_t n = generator.size();
+  std::vector<char> ids(count * n);
+  size_t written = generator.generate(&ids[0], 7);
+  written += generator.generate(&ids[written * n], count - written);
+
+  std::string payload = first;
+  for(size_t i = 0; i < written; ++i)
+  {
+    std::string id(&ids[i * n], n);
+    BOOST_CHECK_EQUAL(id.substr(0, n - 1), payload);
+    BOOST_CHECK(check_sequence<Features>(make_precheck<Precheck>(id)));
+
+    // Increment the payload.
+    size_t k = payload.size();
+    while(k > 0 && payload[k - 1] == '9')
+      payload[--k] = '0';
+    if(k == 0)
+      break;
+    ++payload[k - 1];
+  }
+}
+
+BOOST_AUTO_TEST_CASE(id_generator_test)
+{
+  check_id_generator<features<luhn>, digit>("441712345678911", 1000);
+  check_id_generator<ean13, digit>("590123412345", 250);
+  check_id_generator<features<ean>, digit>("0099997", 100);
+  check_id_generator<isbn10, digitx>("020170073", 150);
+  check_id_generator<features<verhoeff>, digit>("998", 200);
+
+  // The payloads of the width are exhausted.
+  id_generator<features<luhn> > generator(95, 2);
+  std::vector<char> ids(20 * 3);
+  BOOST_CHECK_EQUAL(generator.generate(&ids[0], 20), 5u);
+  BOOST_CHECK(generator.done());
+  BOOST_CHECK_EQUAL(std::string(&ids[12], 3), "992");
+
+  BOOST_CHECK_THROW(id_generator<features<luhn> >(std::string("4417 1234")), std::invalid_argument);
+  BOOST_CHECK_THROW(id_generator<isbn10>(std::string("02017007X")), std::invalid_argument);
+}
+
+struct id_allocator_worker
+{
+  id_allocator<features<luhn>, 16> *allocator;
+  std::vector<std::string> *ids;
+
+  void operator()() const
+  {
+    id_allocator<features<luhn>, 16>::block block;
+    for(const char *id = allocator->allocate_id(block); id != 0; id = allocator->allocate_id(block))
+      ids->push_back(std::string(id, block.id_size()));
+  }
+};
+
+BOOST_AUTO_TEST_CASE(id_allocator_test)
+{
+  // Four threads share 1000 payloads: every payload is allocated once, with a valid check digit.
+  id_allocator<features<luhn>, 16> allocator(1000, 1999, 6);
+  std::vector<std::string> ids[4];
+  std::vector<std::thread> threads;
+  for(size_t t = 0; t < 4; ++t)
+  {
+    id_allocator_worker worker = { &allocator, &ids[t] };
+    threads.push_back(std::thread(worker));
+  }
+  for(size_t t = 0; t < 4; ++t)
+    threads[t].join();
+
+  std::vector<std::string> all;
+  for(size_t t = 0; t < 4; ++t)
+    all.insert(all.end(), ids[t].begin(), ids[t].end());
+  std::sort(all.begin(), all.end());
+  BOOST_REQUIRE_EQUAL(all.size(), 1000u);
+  for(size_t i = 0; i < all.size(); ++i)
+  {
+    BOOST_CHECK_EQUAL(all[i].substr(0, 6), boost::lexical_cast<std::string>(1000 + i + 1000000).substr(1));
+    BOOST_CHECK(check_luhn(make_precheck<digit>(all[i])));
+  }
+  // The identifiers must fit into a block and the payloads into the width.
+  typedef id_allocator<features<luhn>, 16> allocator_type;
+  BOOST_CHECK_THROW(allocator_type(0, 10, 20), std::invalid_argument);
+  BOOST_CHECK_THROW(allocator_type(0, 1000, 3), std::invalid_argument);
+  BOOST_CHECK_NO_THROW(allocator_type(0, 999, 3));
+}
+
+struct mod97_10_test_validation
+{
+  bool operator()(size_t checksum)
+  {
+    return checksum % 97 == 1;
+  }
+};
+
+struct mod97_10_test_checkdigit
+{
+  static const size_t pos = 0;
+  static const size_t size = 2;
+};
+
+typedef checksum<mod97_10_processor, mod97_10_test_validation, mod97_10, mod97_10_test_checkdigit> mod97_10_test;
+
+template <typename Features, typename Precheck>
+void check_complete_inplace(const char **fields, size_t count)
+{
+  // Records of 40 characters, the field at the offset 5.
+  const size_t stride = 40;
+  std::vector<char> records(count * stride, '.');
+  for(size_t r = 0; r < count; ++r)
+  {
+    std::string field = fields[r];
+    std::copy(field.begin(), field.end(), records.begin() + r * stride + 5);
+  }
+  BOOST_CHECK_EQUAL(complete_inplace<Features>(&records[0], stride, 5, count), count);
+  for(size_t r = 0; r < count; ++r)
+  {
+    std::string record(&records[r * stride], stride);
+    std::string field = record.substr(5, Features::size);
+    BOOST_CHECK_EQUAL(field.substr(0, Features::size - 2), std::string(fields[r]).substr(0, Features::size - 2));
+    BOOST_CHECK(check_sequence<Features>(make_precheck<Precheck>(field)));
+    BOOST_CHECK_EQUAL(record.substr(0, 5), ".....");
+    BOOST_CHECK_EQUAL(record.substr(5 + Features::size), std::string(stride - 5 - Features::size, '.'));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(complete_inplace_test)
+{
+  const char *ean13_fields[] = { "590123412345?", "400638133393?", "000000000000?" };
+  const char *isbn10_fields[] = { "020170073?", "080442957?", "123456789?" };
+  const char *visa_fields[] = { "441712345678911?", "400000000000000?" };
+  const char *verhoeff_fields[] = { "236?", "123?", "000?" };
+  const char *mod97_fields[] = { "5100075470611114??", "0000000000000000??" };
+  check_complete_inplace<ean13, digit>(ean13_fields, 3);
+  check_complete_inplace<isbn10, digitx>(isbn10_fields, 3);
+  check_complete_inplace<visa, digit>(visa_fields, 2);
+  check_complete_inplace<features<verhoeff, 4>, digit>(verhoeff_fields, 3);
+  check_complete_inplace<features<mod97_10_test, 18>, digit>(mod97_fields, 2);
+
+  // 200 records, more than a batch, with an invalid payload left untouched.
+  std::vector<char> records(200 * 16, '0');
+  for(size_t r = 0; r < 200; ++r)
+    records[r * 16 + 15] = '?';
+  records[150 * 16 + 3] = 'a';
+  BOOST_CHECK_EQUAL((complete_inplace<features<luhn, 16> >(&records[0], 16, 0, 200)), 199u);
+  BOOST_CHECK_EQUAL(records[149 * 16 + 15], '0');
+  BOOST_CHECK_EQUAL(records[150 * 16 + 15], '?');
+
+  // The same with Verhoeff, a space and a letter in the payloads.
+  std::string verhoeff_records = "236?12 ?1a3?000?";
+  BOOST_CHECK_EQUAL((complete_inplace<features<verhoeff, 4> >(&verhoeff_records[0], 4, 0, 4)), 2u);
+  BOOST_CHECK_EQUAL(verhoeff_records.substr(4, 8), "12 ?1a3?");
+  std::string first_record = verhoeff_records.substr(0, 4), last_record = verhoeff_records.substr(12, 4);
+  BOOST_CHECK((check_sequence<features<verhoeff, 4> >(make_precheck<digit>(first_record))));
+  BOOST_CHECK((check_sequence<features<verhoeff, 4> >(make_precheck<digit>(last_record))));
+}
+
+BOOST_AUTO_TEST_CASE(integer_input_test)
+{
+  // A leading zero is implicit for the fixed size schemes.
+  BOOST_CHECK(check_integer<upca>(36000291452ull));
+  BOOST_CHECK_EQUAL(check_integer<upca>(36000291453ull), false);
+  BOOST_CHECK_EQUAL(check_integer<upca>(1036000291452ull), false);
+  BOOST_CHECK_EQUAL(compute_integer<upca>(3600029145ull), 2u);
+  BOOST_CHECK(check_integer<ean13>(5901234123457ull));
+  BOOST_CHECK(check_integer<visa>(4417123456789113ull));
+  BOOST_CHECK_EQUAL(compute_integer<visa>(441712345678911ull), 3u);
+  BOOST_CHECK_EQUAL(compute_integer<ean13>(10000000000000ull), bad_sequence);
+
+  std::vector<boost::uint64_t> values;
+  std::srand(3);
+  for(size_t i = 0; i < 300; ++i)
+    values.push_back((boost::uint64_t(std::rand()) << 32 | std::rand()) % 100000000000000ull);
+  values.push_back(0);
+  values.push_back(18446744073709551615ull);
+
+  boost::scoped_array<bool> luhn_valid(new bool[values.size()]), ean13_valid(new bool[values.size()]), verhoeff_valid(new bool[values.size()]);
+  size_t luhn_count = check_integer<features<luhn> >(&values[0], values.size(), luhn_valid.get());
+  size_t ean13_count = check_integer<ean13>(&values[0], values.size(), ean13_valid.get());
+  check_integer<features<verhoeff> >(&values[0], values.size(), verhoeff_valid.get());
+
+  size_t expected_luhn = 0, expected_ean13 = 0;
+  for(size_t i = 0; i < values.size(); ++i)
+  {
+    std::string x = boost::lexical_cast<std::string>(values[i]);
+    std::string padded = std::string(x.size() < EAN13_SIZE ? EAN13_SIZE - x.size() : 0, '0') + x;
+    bool luhn_expected = check_sequence<features<luhn> >(make_precheck<digit>(x));
+    bool ean13_expected = check_sequence<ean13>(make_precheck<digit>(padded));
+    BOOST_CHECK_EQUAL(luhn_valid[i], luhn_expected);
+    BOOST_CHECK_EQUAL(ean13_valid[i], ean13_expected);
+    BOOST_CHECK_EQUAL(verhoeff_valid[i], check_sequence<features<verhoeff> >(make_precheck<digit>(x)));
+    BOOST_CHECK_EQUAL(check_integer<features<luhn> >(values[i]), luhn_expected);
+    expected_luhn += luhn_expected;
+    expected_ean13 += ean13_expected;
+  }
+  BOOST_CHECK_EQUAL(luhn_count, expected_luhn);
+  BOOST_CHECK_EQUAL(ean13_count, expected_ean13);
+}
+
+// Zoned fields of field_size bytes, right aligned and padded with 0xF0.
+std::vector<unsigned char> make_zoned(const std::string &x, size_t field_size)
+{
+  std::vector<unsigned char> field(field_size, 0xF0);
+  for(size_t i = 0; i < x.size(); ++i)
+    field[field_size - x.size() + i] = static_cast<unsigned char>(x[i] + 0xC0);
+  return field;
+}
+
+// Packed fields of field_size bytes, padded with zeros, the sign being 0xC.
+std::vector<unsigned char> make_packed(const std::string &x, size_t field_size)
+{
+  std::string digits = std::string(2 * field_size - 1 - x.size(), '0') + x;
+  std::vector<unsigned char> field(field_size);
+  for(size_t i = 0; i < field_size; ++i)
+  {
+    size_t high = digits[2 * i] - '0';
+    size_t low = i + 1 < field_size ? digits[2 * i + 1] - '0' : 0x0C;
+    field[i] = static_cast<unsigned char>(high << 4 | low);
+  }
+  return field;
+}
+
+template <typename Features>
+void check_mainframe(const std::vector<std::string> &numbers, size_t zoned_size, size_t packed_size)
+{
+  std::vector<unsigned char> zoned, packed;
+  for(size_t i = 0; i < numbers.size(); ++i)
+  {
+    std::vector<unsigned char> z = make_zoned(numbers[i], zoned_size);
+    std::vector<unsigned char> p = make_packed(numbers[i], packed_size);
+    zoned.insert(zoned.end(), z.begin(), z.end());
+    packed.insert(packed.end(), p.begin(), p.end());
+  }
+  boost::scoped_array<bool> zoned_valid(new bool[numbers.size()]), packed_valid(new bool[numbers.size()]);
+  size_t zoned_count = check_zoned<Features>(&zoned[0], zoned_size, zoned_size, numbers.size(), zoned_valid.get());
+  size_t packed_count = check_packed<Features>(&packed[0], packed_size, packed_size, numbers.size(), packed_valid.get());
+
+  size_t expected_count = 0;
+  for(size_t i = 0; i < numbers.size(); ++i)
+  {
+    // The fields are numbers: their leading zeros are not part of a sequence without size.
+    std::string x = Features::size ? numbers[i] : numbers[i].substr((std::min)(numbers[i].find_first_not_of('0'), numbers[i].size() - 1));
+    bool expected = check_sequence<Features>(make_precheck<digit>(x));
+    BOOST_CHECK_EQUAL(zoned_valid[i], expected);
+    BOOST_CHECK_EQUAL(packed_valid[i], expected);
+    BOOST_CHECK_EQUAL(check_packed<Features>(&packed[i * packed_size], packed_size), expected);
+    expected_count += expected;
+  }
+  BOOST_CHECK_EQUAL(zoned_count, expected_count);
+  BOOST_CHECK_EQUAL(packed_count, expected_count);
+}
+
+BOOST_AUTO_TEST_CASE(mainframe_test)
+{
+  std::vector<unsigned char> visa_number = make_zoned("4417123456789113", 16);
+  BOOST_CHECK(check_sequence<visa>(make_precheck<ebcdic_digit>(visa_number)));
+  BOOST_CHECK(check_zoned<visa>(&visa_number[0], visa_number.size()));
+  BOOST_CHECK(check_packed<ean13>(&make_packed("5901234123457", 7)[0], 7));
+  BOOST_CHECK(check_packed<upca>(&make_packed("36000291452", 7)[0], 7));
+  BOOST_CHECK_EQUAL(check_packed<upca>(&make_packed("1036000291452", 7)[0], 7), false);
+  BOOST_CHECK((check_packed<features<mod97_10_test, 18> >(&make_packed("510007547061111462", 10)[0], 10)));
+
+  visa_number[3] = 0x47;
+  BOOST_CHECK_EQUAL(check_zoned<visa>(&visa_number[0], visa_number.size()), false);
+  std::vector<unsigned char> unsigned_field = make_packed("5901234123457", 7);
+  unsigned_field[6] &= 0xF3;
+  BOOST_CHECK_EQUAL(check_packed<ean13>(&unsigned_field[0], 7), false);
+
+  // Corrupt bytes with Verhoeff: an EBCDIC space in a zoned field, a sign nibble in the digits of a packed field.
+  std::vector<unsigned char> verhoeff_zoned = make_zoned("2363", 6);
+  BOOST_CHECK(check_zoned<features<verhoeff> >(&verhoeff_zoned[0], verhoeff_zoned.size()));
+  verhoeff_zoned[3] = 0x40;
+  BOOST_CHECK_EQUAL(check_zoned<features<verhoeff> >(&verhoeff_zoned[0], verhoeff_zoned.size()), false);
+  std::vector<unsigned char> verhoeff_packed = make_packed("2363", 3);
+  BOOST_CHECK(check_packed<features<verhoeff> >(&verhoeff_packed[0], verhoeff_packed.size()));
+  verhoeff_packed[1] |= 0x0F;
+  BOOST_CHECK_EQUAL(check_packed<features<verhoeff> >(&verhoeff_packed[0], verhoeff_packed.size()), false);
+
+  std::vector<std::string> numbers, ean13_numbers;
+  std::srand(5);
+  for(size_t i = 0; i < 200; ++i)
+  {
+    std::string x;
+    for(size_t k = 0; k < 13; ++k)
+      x += static_cast<char>('0' + std::rand() % 10);
+    ean13_numbers.push_back(x);
+    numbers.push_back(x.substr(std::rand() % 6));
+  }
+  check_mainframe<ean13>(ean13_numbers, 13, 7);
+  check_mainframe<features<luhn> >(numbers, 15, 9);
+  check_mainframe<features<verhoeff> >(numbers, 15, 9);
+}
+
+BOOST_AUTO_TEST_CASE(packed_key_test)
+{
+  std::string ean = "5901234123457";
+  boost::uint64_t key = 0;
+  BOOST_CHECK((check_and_pack<ean13, binary_key>(make_precheck<digit>(ean), key)));
+  BOOST_CHECK_EQUAL(key, 5901234123457ull);
+  BOOST_CHECK((check_and_pack<ean13, binary_key>(make_precheck<digit>(ean), key, true)));
+  BOOST_CHECK_EQUAL(key, 590123412345ull);
+  BOOST_CHECK((check_and_pack<ean13, bcd_key>(make_precheck<digit>(ean), key)));
+  BOOST_CHECK_EQUAL(key, 0x5901234123457ull);
+
+  std::string isbn = "0-8044-2957-X";
+  BOOST_CHECK((check_and_pack<isbn10, bcd_key>(make_precheck<digitx>(isbn), key)));
+  BOOST_CHECK_EQUAL(key, 0x080442957Aull);
+  BOOST_CHECK_EQUAL((check_and_pack<isbn10, binary_key>(make_precheck<digitx>(isbn), key)), false);
+  BOOST_CHECK((check_and_pack<isbn10, binary_key>(make_precheck<digitx>(isbn), key, true)));
+  BOOST_CHECK_EQUAL(key, 80442957u);
+
+  // 20 digits do not fit in a 64 bits key.
+  std::string long_luhn = "12345678901234567894";
+  BOOST_CHECK(check_sequence<features<luhn> >(make_precheck<digit>(long_luhn)));
+  BOOST_CHECK_EQUAL((check_and_pack<features<luhn>, binary_key>(make_precheck<digit>(long_luhn), key)), false);
+  key128 wide;
+  BOOST_CHECK((check_and_pack<features<luhn>, bcd128_key>(make_precheck<digit>(long_luhn), wide)));
+  BOOST_CHECK_EQUAL(wide.high, 0x1234u);
+  BOOST_CHECK_EQUAL(wide.low, 0x5678901234567894ull);
+
+  std::string bban = "510007547061111462";
+  BOOST_CHECK((check_and_pack<features<mod97_10_test, 18>, binary_key>(make_precheck<digit>(bban), key, true)));
+  BOOST_CHECK_EQUAL(key, 5100075470611114ull);
+
+  std::vector<std::string> sequences;
+  sequences.push_back("4417123456789113");
+  sequences.push_back("4417123456789112");
+  sequences.push_back("4417 1234 5678 9113");
+  sequences.push_back("4111111111111111");
+  boost::uint64_t keys[4];
+  bool valid[4];
+  BOOST_CHECK_EQUAL((check_and_pack<visa, binary_key, digit>(sequences.begin(), sequences.end(), keys, valid, true)), 3u);
+  BOOST_CHECK_EQUAL(keys[0], 441712345678911ull);
+  BOOST_CHECK_EQUAL(valid[1], false);
+  BOOST_CHECK_EQUAL(keys[1], 0u);
+  BOOST_CHECK_EQUAL(keys[2], keys[0]);
+  BOOST_CHECK_EQUAL(keys[3], 411111111111111ull);
+}
+
+template <typename Features, typename Precheck>
+void check_columns(const std::vector<std::string> &rows, size_t width)
+{
+  std::string data, fixed_data;
+  std::vector<boost::int32_t> offsets(1, 0);
+  std::vector<boost::uint8_t> validity((rows.size() + 7) / 8, 0);
+  for(size_t i = 0; i < rows.size(); ++i)
+  {
+    data += rows[i];
+    offsets.push_back(static_cast<boost::int32_t>(data.size()));
+    fixed_data += rows[i].substr(0, width) + std::string(width - (std::min)(width, rows[i].size()), ' ');
+    if(i % 7 != 3)
+      validity[i / 8] |= 1 << (i % 8);
+  }
+  std::vector<bitmap_word> bitmap(bitmap_size(rows.size())), fixed_bitmap(bitmap_size(rows.size()));
+  std::vector<boost::uint32_t> failures(rows.size()), fixed_failures(rows.size());
+  size_t failure_count = check_column<Features, Precheck>(data.data(), &offsets[0], rows.size(), &validity[0], &bitmap[0], &failures[0]);
+  size_t fixed_failure_count = check_fixed_column<Features, Precheck>(fixed_data.data(), width, rows.size(), &validity[0],
+                                                                      &fixed_bitmap[0], &fixed_failures[0]);
+
+  std::vector<boost::uint32_t> expected_failures, expected_fixed_failures;
+  size_t expected_valid = 0;
+  for(size_t i = 0; i < rows.size(); ++i)
+  {
+    bool not_null = (validity[i / 8] >> (i % 8)) & 1;
+    std::string fixed_row = fixed_data.substr(i * width, width);
+    bool valid = not_null && check_sequence<Features>(make_precheck<Precheck>(rows[i]));
+    bool fixed_valid = not_null && check_sequence<Features>(make_precheck<Precheck>(fixed_row));
+    BOOST_CHECK_EQUAL(bitmap_test(&bitmap[0], i), valid);
+    BOOST_CHECK_EQUAL(bitmap_test(&fixed_bitmap[0], i), fixed_valid);
+    if(not_null && !valid)
+      expected_failures.push_back(static_cast<boost::uint32_t>(i));
+    if(not_null && !fixed_valid)
+      expected_fixed_failures.push_back(static_cast<boost::uint32_t>(i));
+    expected_valid += valid;
+  }
+  BOOST_CHECK_EQUAL(failure_count, expected_failures.size());
+  BOOST_CHECK(std::equal(expected_failures.begin(), expected_failures.end(), failures.begin()));
+  BOOST_CHECK_EQUAL(fixed_failure_count, expected_fixed_failures.size());
+  BOOST_CHECK(std::equal(expected_fixed_failures.begin(), expected_fixed_failures.end(), fixed_failures.begin()));
+  BOOST_CHECK_EQUAL((check_column<Features, Precheck>(data.data(), &offsets[0], rows.size(), &validity[0], &bitmap[0])), expected_valid);
+}
+
+BOOST_AUTO_TEST_CASE(columnar_test)
+{
+  std::vector<std::string> rows;
+  std::srand(7);
+  for(size_t i = 0; i < 150; ++i)
+  {
+    std::string x = "4";
+    for(size_t k = 1; k < 16; ++k)
+      x += static_cast<char>('0' + std::rand() % 10);
+    x[15] = static_cast<char>('0' + compute_checkdigit<visa>(make_precheck<digit>(x)));
+    if(i % 5 == 1)
+      x[std::rand() % 16] = static_cast<char>('0' + std::rand() % 10);
+    if(i % 11 == 2)
+      x.insert(4, " ");
+    if(i % 13 == 4)
+      x.erase(9);
+    rows.push_back(x);
+  }
+  check_columns<visa, digit>(rows, 16);
+  check_columns<features<luhn>, digit>(rows, 16);
+  check_columns<features<verhoeff>, digit>(rows, 16);
+
+  std::vector<std::string> isbns;
+  isbns.push_back("080442957X");
+  isbns.push_back("0201700735");
+  isbns.push_back("0201700734");
+  check_columns<isbn10, digitx>(isbns, 10);
+
+  // Without validity bitmap, no row is null.
+  std::string fixed = "59012341234575901234123458";
+  bitmap_word bitmap[1];
+  BOOST_CHECK_EQUAL((check_fixed_column<ean13, digit>(fixed.data(), 13, 2, 0, bitmap)), 1u);
+  BOOST_CHECK_EQUAL(bitmap[0], 1u);
+}
+
+BOOST_AUTO_TEST_CASE(batch_scheduler_test)
+{
+  enum { visa_tag, ean13_tag, iban_tag, verhoeff_tag, unknown_tag = 7 };
+  batch_scheduler scheduler;
+  scheduler.add<visa, digit>(visa_tag);
+  scheduler.add<ean13, digit>(ean13_tag);
+  scheduler.add<features<mod97_10_test, 18>, digit>(iban_tag);
+  scheduler.add<features<verhoeff>, digit>(verhoeff_tag);
+
+  const char *visa_numbers[] = { "4417123456789113", "4417123456789112", "4111111111111111", "4417 1234 5678 9113" };
+  const char *ean13_numbers[] = { "5901234123457", "5901234123458", "4006381333931" };
+  const char *iban_numbers[] = { "510007547061111462", "511007547061111462" };
+  const char *verhoeff_numbers[] = { "2363", "2364", "12340", "123406" };
+
+  std::vector<std::string> storage;
+  std::vector<size_t> tags;
+  std::srand(11);
+  for(size_t i = 0; i < 200; ++i)
+  {
+    size_t tag = std::rand() % 5;
+    switch(tag)
+    {
+      case visa_tag: storage.push_back(visa_numbers[std::rand() % 4]); break;
+      case ean13_tag: storage.push_back(ean13_numbers[std::rand() % 3]); break;
+      case iban_tag: storage.push_back(iban_numbers[std::rand() % 2]); break;
+      case verhoeff_tag: storage.push_back(verhoeff_numbers[std::rand() % 4]); break;
+      default: tag = unknown_tag; storage.push_back(visa_numbers[0]);
+    }
+    tags.push_back(tag);
+  }
+
+  std::vector<tagged_sequence> batch(storage.size());
+  size_t expected_count = 0;
+  std::vector<bool> expected(storage.size());
+  for(size_t i = 0; i < storage.size(); ++i)
+  {
+    tagged_sequence x = { tags[i], storage[i].data(), storage[i].size() };
+    batch[i] = x;
+    switch(tags[i])
+    {
+      case visa_tag: expected[i] = check_sequence<visa>(make_precheck<digit>(storage[i])); break;
+      case ean13_tag: expected[i] = check_sequence<ean13>(make_precheck<digit>(storage[i])); break;
+      case iban_tag: expected[i] = check_sequence<features<mod97_10_test, 18> >(make_precheck<digit>(storage[i])); break;
+      case verhoeff_tag: expected[i] = check_sequence<features<verhoeff> >(make_precheck<digit>(storage[i])); break;
+      default: expected[i] = false;
+    }
+    expected_count += expected[i];
+  }
+
+  boost::scoped_array<bool> valid(new bool[storage.size()]);
+  BOOST_CHECK_EQUAL(scheduler.check(&batch[0], batch.size(), valid.get()), expected_count);
+  for(size_t i = 0; i < storage.size(); ++i)
+    BOOST_CHECK_EQUAL(valid[i], expected[i]);
+}
+
+template <typename Features>
+bool detected(const std::string &x, scheme_set schemes, scheme_flag scheme)
+{
+  return check_sequence<Features>(make_precheck<digit>(x)) == ((schemes & scheme) != 0);
+}
+
+BOOST_AUTO_TEST_CASE(scheme_detection_test)
+{
+  BOOST_CHECK_EQUAL(detect_schemes(std::string("4417123456789113")), scheme_set(luhn_scheme | visa_scheme));
+  BOOST_CHECK_EQUAL(detect_schemes(std::string("5500 0000 0000 0004")), scheme_set(luhn_scheme | mastercard_scheme));
+  BOOST_CHECK_EQUAL(detect_schemes(std::string("2221000000000009")), scheme_set(luhn_scheme | mastercard_scheme));
+  BOOST_CHECK_EQUAL(detect_schemes(std::string("378282246310005")), scheme_set(luhn_scheme | amex_scheme));
+  BOOST_CHECK_EQUAL(detect_schemes(std::string("978-0-306-40615-7")), scheme_set(ean13_scheme | isbn13_scheme));
+  BOOST_CHECK_EQUAL(detect_schemes(std::string("036000291452")) & upca_scheme, scheme_set(upca_scheme));
+  BOOST_CHECK_EQUAL(detect_schemes(std::string("0-8044-2957-X")), scheme_set(isbn10_scheme));
+  BOOST_CHECK_EQUAL(detect_schemes(std::string("0-8044-X957-X")), scheme_set(0));
+  BOOST_CHECK(detect_schemes(std::string("510007547061111462")) & mod97_10_scheme);
+  BOOST_CHECK_EQUAL(detect_schemes(std::string("")), scheme_set(0));
+
+  std::srand(13);
+  for(size_t i = 0; i < 2000; ++i)
+  {
+    std::string x;
+    size_t size = 7 + std::rand() % 13;
+    for(size_t k = 0; k < size; ++k)
+      x += static_cast<char>('0' + std::rand() % 10);
+    scheme_set schemes = detect_schemes(x);
+    BOOST_CHECK(detected<features<luhn> >(x, schemes, luhn_scheme));
+    BOOST_CHECK(detected<ean8>(x, schemes, ean8_scheme));
+    BOOST_CHECK(detected<upca>(x, schemes, upca_scheme));
+    BOOST_CHECK(detected<ean13>(x, schemes, ean13_scheme));
+    BOOST_CHECK(detected<gtin14>(x, schemes, gtin14_scheme));
+    BOOST_CHECK(detected<isbn10>(x, schemes, isbn10_scheme));
+    // The features types of the cards have no prefix rule.
+    bool amex_prefix = x.compare(0, 2, "34") == 0 || x.compare(0, 2, "37") == 0;
+    BOOST_CHECK_EQUAL((schemes & amex_scheme) != 0, amex_prefix && check_sequence<amex>(make_precheck<digit>(x)));
+    BOOST_CHECK_EQUAL((schemes & visa_scheme) != 0, x[0] == '4' && check_sequence<visa>(make_precheck<digit>(x)));
+    BOOST_CHECK_EQUAL((schemes & mod97_10_scheme) != 0,
+                      check_sequence<features<mod97_10_test> >(make_precheck<digit>(x)));
+  }
+}
+
+BOOST_AUTO_TEST_CASE(scheme_registry_test)
+{
+  scheme_registry registry = make_builtin_registry();
+  BOOST_CHECK(registry.find("unknown") == 0);
+
+  std::string visa_number = "4417123456789113";
+  BOOST_CHECK(registry.find("visa")->check(visa_number.data(), visa_number.size()));
+  BOOST_CHECK(registry.find("luhn")->check(visa_number.data(), visa_number.size()));
+  BOOST_CHECK(!registry.find("ean13")->check(visa_number.data(), visa_number.size()));
+
+  std::vector<std::string> ibans;
+  ibans.push_back("BE62 5100 0754 7061");
+  ibans.push_back("GB82 WEST 1234 5698 7654 32");
+  ibans.push_back("gb82west12345698765432");
+  ibans.push_back("GB82 WEST 1234 5698 7654 33");
+  ibans.push_back("GB82 WEST 1234 5698 7654 3");
+  ibans.push_back("12GB WEST 1234 5698 7654 32");
+  bool valid[6];
+  BOOST_CHECK_EQUAL(registry.find("iban")->check(&ibans[0], ibans.size(), valid), 3u);
+  BOOST_CHECK(valid[0] && valid[1] && valid[2]);
+
+  std::vector<std::string> vins;
+  vins.push_back("1M8GDM9AXKP042788");
+  vins.push_back("11111111111111111");
+  vins.push_back("1M8GDM9A1KP042788");
+  vins.push_back("1M8GDM9AXKP04278");
+  vins.push_back("1M8GDM9AXKO042788");
+  BOOST_CHECK_EQUAL(registry.find("vin")->check(&vins[0], vins.size(), valid), 2u);
+  BOOST_CHECK(valid[0] && valid[1]);
+
+  // The compiled tables agree with the features types.
+  weighted_modulus_scheme ean;
+  ean.weights.push_back(1);
+  ean.weights.push_back(3);
+  ean.size = EAN13_SIZE;
+  registry.add("runtime_ean13", ean);
+  weighted_modulus_scheme isbn;
+  for(size_t w = 1; w <= 10; ++w)
+    isbn.weights.push_back(w);
+  isbn.modulus = 11;
+  isbn.size = ISBN10_SIZE;
+  isbn.checkdigit_transliteration = isbn.transliteration;
+  isbn.checkdigit_transliteration['X'] = isbn.checkdigit_transliteration['x'] = 10;
+  registry.add("runtime_isbn10", isbn);
+
+  std::vector<std::string> sequences;
+  std::srand(17);
+  for(size_t i = 0; i < 500; ++i)
+  {
+    std::string x;
+    size_t size = 9 + std::rand() % 6;
+    for(size_t k = 0; k < size; ++k)
+      x += static_cast<char>('0' + std::rand() % 10);
+    if(i % 7 == 0)
+      x.insert(3, "-");
+    if(i % 11 == 0)
+      x[x.size() - 1] = 'X';
+    sequences.push_back(x);
+  }
+  boost::scoped_array<bool> results(new bool[sequences.size()]);
+  bool *r = results.get();
+  registry.find("runtime_ean13")->check(&sequences[0], sequences.size(), r);
+  for(size_t i = 0; i < sequences.size(); ++i)
+    BOOST_CHECK_EQUAL(r[i], check_sequence<ean13>(make_precheck<digit>(sequences[i])) && sequences[i][sequences[i].size() - 1] != 'X');
+  registry.find("runtime_isbn10")->check(&sequences[0], sequences.size(), r);
+  for(size_t i = 0; i < sequences.size(); ++i)
+    BOOST_CHECK_EQUAL(r[i], check_sequence<isbn10>(make_precheck<digitx>(sequences[i])));
+  registry.find("ean13")->check(&sequences[0], sequences.size(), r);
+  for(size_t i = 0; i < sequences.size(); ++i)
+    BOOST_CHECK_EQUAL(r[i], check_sequence<ean13>(make_precheck<digit>(sequences[i])));
+}
+
+BOOST_AUTO_TEST_CASE(kernel_planner_test)
+{
+  const char *path = "kernel_planner_test.plan";
+  std::remove(path);
+  {
+    std::ofstream other(path);
+    other << "Another CPU\tvisa\t16\tscalar\n";
+  }
+
+  std::string column = "44171234567891134417123456789112";
+  bitmap_word bitmap[1];
+  {
+    kernel_planner planner(path);
+    BOOST_CHECK(planner.planned("visa", 16).empty());
+    column_kernel kernel = planner.plan<visa, digit>("visa", 16);
+    BOOST_CHECK(!planner.planned("visa", 16).empty());
+    BOOST_CHECK_EQUAL(kernel(column.data(), 16, 2, 0, bitmap), 1u);
+    BOOST_CHECK_EQUAL(bitmap[0], 1u);
+    planner.plan<features<verhoeff>, digit>("verhoeff", 8);
+    BOOST_CHECK(planner.save());
+  }
+  {
+    // The plans are loaded, the other CPU line is kept.
+    kernel_planner planner(path);
+    std::string name = planner.planned("visa", 16);
+    BOOST_CHECK(name == "scalar" || name == "column");
+    BOOST_CHECK(!planner.planned("verhoeff", 8).empty());
+    BOOST_CHECK_EQUAL((planner.plan<visa, digit>("visa", 16)(column.data(), 16, 2, 0, bitmap)), 1u);
+
+    // The scheduler validates the buckets of a named scheme with its planned kernel, planning the new sizes.
+    batch_scheduler scheduler(planner);
+    scheduler.add<visa, digit>(0, "visa");
+    scheduler.add<ean13, digit>(1);
+    tagged_sequence batch[] = { { 0, "4417123456789113", 16 }, { 1, "5901234123457", 13 }, { 0, "4417123456789112", 16 },
+                                { 0, "4111111111111111", 16 }, { 0, "4111 1111 1111 1111", 19 } };
+    bool valid[5];
+    BOOST_CHECK_EQUAL(scheduler.check(batch, 5, valid), 4u);
+    BOOST_CHECK(valid[0] && valid[1] && !valid[2] && valid[3] && valid[4]);
+    BOOST_CHECK(!planner.planned("visa", 19).empty());
+    BOOST_CHECK(planner.planned("ean13", 13).empty());
+    BOOST_CHECK(planner.save());
+  }
+  std::ifstream file(path);
+  std::string first_line;
+  std::getline(file, first_line);
+  BOOST_CHECK_EQUAL(first_line, "Another CPU\tvisa\t16\tscalar");
+  file.close();
+  std::remove(path);
+}
+
 BOOST_AUTO_TEST_CASE(luhn_test)
 {
   unsigned int transpositions_failures = transposition(luhn_functor());
-  BOOST_CHECKDIGIT_MESSAGE(transpositions_failures == 2, "" <<(90-transpositions_failures)<< " caught on 90.");
+  BOOST_CHECK_MESSAGE(transpositions_failures == 2, "" <<(90-transpositions_failures)<< " caught on 90.");
 
   unsigned int alterations_failures = alteration(luhn_functor(), 2);
-  BOOST_CHECKDIGIT_MESSAGE(alterations_failures == 0, "" <<(18-alterations_failures)<< " caught on 18.");
+  BOOST_CHECK_MESSAGE(alterations_failures == 0, "" <<(18-alterations_failures)<< " caught on 18.");
 }
 
 BOOST_AUTO_TEST_CASE(verhoeff_test)
 {
   unsigned int transpositions_failures = transposition(verhoeff_functor());
-  BOOST_CHECKDIGIT_MESSAGE(transpositions_failures == 0, "" <<(90-transpositions_failures)<< " caught on 90.");
+  BOOST_CHECK_MESSAGE(transpositions_failures == 0, "" <<(90-transpositions_failures)<< " caught on 90.");
 
   unsigned int alterations_failures = alteration(verhoeff_functor(), 20);
-  BOOST_CHECKDIGIT_MESSAGE(alterations_failures == 0, "" <<(180-alterations_failures)<< " caught on 180.");
+  BOOST_CHECK_MESSAGE(alterations_failures == 0, "" <<(180-alterations_failures)<< " caught on 180.");
 }
 
 BOOST_AUTO_TEST_CASE(modulus11_test)
 {
   unsigned int transpositions_failures = transposition(modulus11_functor());
-  BOOST_CHECKDIGIT_MESSAGE(transpositions_failures == 0, "" <<(90-transpositions_failures)<< " caught on 90.");
+  BOOST_CHECK_MESSAGE(transpositions_failures == 0, "" <<(90-transpositions_failures)<< " caught on 90.");
 
   unsigned int alterations_failures = alteration(modulus11_functor(), 10);
-  BOOST_CHECKDIGIT_MESSAGE(alterations_failures == 0, "" <<(90-alterations_failures)<< " caught on 90.");
+  BOOST_CHECK_MESSAGE(alterations_failures == 0, "" <<(90-alterations_failures)<< " caught on 90.");
 }
 
 BOOST_AUTO_TEST_SUITE_END()